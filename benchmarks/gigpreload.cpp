@@ -0,0 +1,120 @@
+/*
+    Compressed .gig sample preload benchmark
+
+    Measures what decompressing short compressed samples at instrument load
+    time (configure option --enable-preload-compressed-samples) saves the
+    disk thread. For every compressed sample of the given .gig file with at
+    most MAXSAMPLES sample points it compares:
+
+    - streaming: reading the whole sample with gig::Sample::Read() in
+      refills of CONFIG_STREAM_MAX_REFILL_SIZE sample points, which is what
+      the disk thread has to do for each voice playing the sample, and
+
+    - preloaded: copying the sample from its RAM cache, which is what a RAM
+      voice costs once the sample was decompressed on load,
+
+    and prints the one-time cost of the preload and the RAM it takes.
+
+    Usage: ./gigpreload FILE.gig [MAXSAMPLES]
+
+    Copyright (c) 2026 The LinuxSampler Developers
+*/
+
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <gig.h>
+
+// fragment size the silence extension of the RAM cache is made for
+#define FRAGMENTSIZE    256
+
+// default max. size of the samples to test (in sample points)
+#define MAXSAMPLES      1048576
+
+// how often each sample is streamed and copied
+#define RUNS            20
+
+static double msSince(clock_t start_time) {
+    return (clock() - start_time) / (double(CLOCKS_PER_SEC) / 1000.0);
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s FILE.gig [MAXSAMPLES]\n", argv[0]);
+        return -1;
+    }
+    const unsigned long maxSamples =
+        (argc > 2) ? strtoul(argv[2], NULL, 10) : MAXSAMPLES;
+
+    try {
+        RIFF::File riff(argv[1]);
+        gig::File gig(&riff);
+
+        gig::buffer_t decompressionBuffer =
+            gig::Sample::CreateDecompressionBuffer(CONFIG_STREAM_MAX_REFILL_SIZE);
+        char* pOutput = new char[CONFIG_STREAM_MAX_REFILL_SIZE * 6]; // max. 24 bit stereo
+
+        int samples = 0;
+        double streamedSeconds = 0, streamTime = 0, copyTime = 0, preloadTime = 0;
+        unsigned long long ramBytes = 0;
+
+        for (gig::Sample* pSample = gig.GetFirstSample(); pSample; pSample = gig.GetNextSample()) {
+            if (!pSample->Compressed || !pSample->SamplesTotal ||
+                pSample->SamplesTotal > maxSamples) continue;
+            samples++;
+            streamedSeconds += RUNS * double(pSample->SamplesTotal) / pSample->SamplesPerSecond;
+
+            // what the disk thread does for each voice streaming the sample
+            clock_t start_time = clock();
+            for (int i = 0; i < RUNS; i++) {
+                pSample->SetPos(0);
+                while (pSample->Read(pOutput, CONFIG_STREAM_MAX_REFILL_SIZE, &decompressionBuffer));
+            }
+            streamTime += msSince(start_time);
+
+            // the one-time cost of decompressing the sample on instrument load
+            start_time = clock();
+            gig::buffer_t cache = pSample->LoadSampleDataWithNullSamplesExtension(
+                (FRAGMENTSIZE << CONFIG_MAX_PITCH) + 3
+            );
+            preloadTime += msSince(start_time);
+            ramBytes += cache.Size + cache.NullExtensionSize;
+
+            // what a RAM voice costs instead (the engine reads the cache
+            // directly, so this is rather an upper bound)
+            start_time = clock();
+            for (int i = 0; i < RUNS; i++) {
+                for (unsigned long pos = 0; pos < cache.Size; pos += CONFIG_STREAM_MAX_REFILL_SIZE * pSample->FrameSize) {
+                    unsigned long n = cache.Size - pos;
+                    if (n > CONFIG_STREAM_MAX_REFILL_SIZE * pSample->FrameSize)
+                        n = CONFIG_STREAM_MAX_REFILL_SIZE * pSample->FrameSize;
+                    memcpy(pOutput, (char*) cache.pStart + pos, n);
+                }
+            }
+            copyTime += msSince(start_time);
+
+            pSample->ReleaseSampleData();
+        }
+
+        delete[] pOutput;
+        gig::Sample::DestroyDecompressionBuffer(decompressionBuffer);
+
+        if (!samples) {
+            printf("No compressed samples with at most %lu sample points found.\n", maxSamples);
+            return 0;
+        }
+        printf("%d compressed samples with at most %lu sample points\n", samples, maxSamples);
+        printf("streaming : %1.0f ms for %1.1f s of audio (%1.2f%% of one CPU per voice)\n",
+               streamTime, streamedSeconds, streamTime / (streamedSeconds * 10.0));
+        printf("preloaded : %1.0f ms for %1.1f s of audio (%1.2f%% of one CPU per voice)\n",
+               copyTime, streamedSeconds, copyTime / (streamedSeconds * 10.0));
+        printf("preload   : %1.0f ms once on instrument load, %1.1f MB RAM\n",
+               preloadTime, ramBytes / (1024.0 * 1024.0));
+    } catch (RIFF::Exception e) {
+        e.PrintMessage();
+        return -1;
+    }
+    return 0;
+}
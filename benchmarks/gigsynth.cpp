@@ -6,7 +6,8 @@
     "synthesis mode" (that is all possible cases like filter on / off,
     interpolation on / off, stereo / mono). It uses fake sample data and
     fake audio outputs, so we don't have to load a .gig file or care about
-    drivers.
+    drivers. Each mode is benchmarked with the generic synthesis loops and
+    with the ones of fixed subfragment size.
 
     Copyright (C) 2005,2006 Christian Schoenebeck <cuse@users.sf.net>
 */
@@ -22,9 +23,13 @@
 #include "../src/engines/gig/SynthesisParam.h"
 #include "../src/engines/gig/Synthesizer.h"
 
-#define FRAGMENTSIZE	200
+#define FRAGMENTSIZE	256
 #define RUNS            100000
 
+// the engine renders in subfragments of this size, full subfragments are
+// rendered by the fixed size synthesis functions
+#define SUBFRAGMENTSIZE CONFIG_DEFAULT_SUBFRAGMENT_SIZE
+
 using namespace LinuxSampler;
 using namespace LinuxSampler::gig;
 
@@ -73,30 +78,40 @@ int main() {
     pLoop->uiTotalCycles = 0; // infinity
 
     for (int mode = 0; mode < 32; mode++) {
-            // zero out output buffers
-            memset(pOutputL,0,FRAGMENTSIZE*sizeof(float));
-            memset(pOutputR,0,FRAGMENTSIZE*sizeof(float));
-
-            pParam->filterLeft.Reset();
-            pParam->filterRight.Reset();
-
             printf("Benchmarking ");
             printmode(mode);
 
-            clock_t stop_time;
-            clock_t start_time = clock();
-
-            for (uint i = 0; i < RUNS; i++) {
-                pParam->dPos      = 0.0;
-                pParam->pOutLeft  = pOutputL;
-                pParam->pOutRight = pOutputR;
-                pParam->uiToGo    = FRAGMENTSIZE;
-                // now actually render audio
-                RunSynthesisFunction(mode, pParam, pLoop);
+            float elapsed_time[2];
+            for (int fixed = 0; fixed < 2; fixed++) {
+                int runMode = mode;
+                SYNTHESIS_MODE_SET_FIXEDSIZE(runMode, fixed);
+
+                // zero out output buffers
+                memset(pOutputL,0,FRAGMENTSIZE*sizeof(float));
+                memset(pOutputR,0,FRAGMENTSIZE*sizeof(float));
+
+                pParam->filterLeft.Reset();
+                pParam->filterRight.Reset();
+
+                clock_t stop_time;
+                clock_t start_time = clock();
+
+                for (uint i = 0; i < RUNS; i++) {
+                    pParam->dPos      = 0.0;
+                    pParam->pOutLeft  = pOutputL;
+                    pParam->pOutRight = pOutputR;
+                    // now actually render audio, in subfragments like the engine does
+                    for (uint j = 0; j < FRAGMENTSIZE; j += SUBFRAGMENTSIZE) {
+                        pParam->uiToGo = SUBFRAGMENTSIZE;
+                        RunSynthesisFunction(runMode, pParam, pLoop);
+                    }
+                }
+
+                stop_time = clock();
+                elapsed_time[fixed] = (stop_time - start_time) / (double(CLOCKS_PER_SEC) / 1000.0);
             }
-
-            stop_time = clock();
-            float elapsed_time = (stop_time - start_time) / (double(CLOCKS_PER_SEC) / 1000.0);
-            printf("\t: %1.0f ms\n", elapsed_time);
+            printf("\t: %1.0f ms generic, %1.0f ms fixed size (%d) -> %1.2fx\n",
+                   elapsed_time[0], elapsed_time[1], SUBFRAGMENTSIZE,
+                   elapsed_time[0] / elapsed_time[1]);
     }
 }
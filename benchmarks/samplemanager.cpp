@@ -0,0 +1,205 @@
+/*
+    SampleManager benchmark
+
+    Simulates loading and unloading a large SFZ sample library, that is
+    registering the regions of all instruments as consumers of their samples
+    (looking up already loaded samples by file name first) and removing them
+    again, once with LinuxSampler::SampleManager and once with the former
+    implementation based on std::map<S*, std::set<C*> >.
+
+    Copyright (c) 2026 The LinuxSampler Developers
+*/
+
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <new>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../src/engines/common/SampleManager.h"
+
+// amount of sample files of the simulated library
+#ifndef SAMPLES
+# define SAMPLES		200000
+#endif
+
+// amount of regions per sample (e.g. velocity layers sharing one file)
+#ifndef REGIONS_PER_SAMPLE
+# define REGIONS_PER_SAMPLE	2
+#endif
+
+// how often the library is loaded and unloaded
+#ifndef CYCLES
+# define CYCLES			5
+#endif
+
+// bookkeeping of the heap usage, to compare the memory footprint of both
+// implementations
+
+static size_t heapUsage = 0;
+
+void* operator new(size_t size) throw (std::bad_alloc) {
+    size_t* p = (size_t*) malloc(size + sizeof(size_t) * 2);
+    if (!p) throw std::bad_alloc();
+    p[0] = size;
+    heapUsage += size;
+    return p + 2;
+}
+
+void operator delete(void* ptr) throw () {
+    if (!ptr) return;
+    size_t* p = (size_t*) ptr - 2;
+    heapUsage -= p[0];
+    free(p);
+}
+
+void* operator new[](size_t size) throw (std::bad_alloc) {
+    return operator new(size);
+}
+
+void operator delete[](void* ptr) throw () {
+    operator delete(ptr);
+}
+
+struct Sample {
+    std::string file;
+    Sample(const std::string& file) : file(file) { }
+};
+
+struct Region {
+    Sample* pSample;
+    Region() : pSample(NULL) { }
+};
+
+// sample manager with a file name index, like the one of the SFZ engine
+class IndexedSampleManager : public LinuxSampler::SampleManager<Sample, Region> {
+public:
+    Sample* FindSample(const std::string& file) {
+        LinuxSampler::SmallSet<Sample>* pSamples = samplesByFile.find(LinuxSampler::HashOf(file));
+        if (!pSamples) return NULL;
+        for (size_t i = 0; i < pSamples->size(); i++)
+            if ((*pSamples)[i]->file == file) return (*pSamples)[i];
+        return NULL;
+    }
+
+protected:
+    virtual void OnSampleAdded(Sample* pSample) {
+        samplesByFile[LinuxSampler::HashOf(pSample->file)].insert(pSample);
+    }
+
+    virtual void OnSampleRemoved(Sample* pSample) {
+        const size_t hash = LinuxSampler::HashOf(pSample->file);
+        LinuxSampler::SmallSet<Sample>* pSamples = samplesByFile.find(hash);
+        if (!pSamples) return;
+        pSamples->erase(pSample);
+        if (pSamples->empty()) samplesByFile.erase(hash);
+    }
+
+private:
+    LinuxSampler::HashMap<size_t, LinuxSampler::SmallSet<Sample> > samplesByFile;
+};
+
+// the former SampleManager implementation, with a file name index as well,
+// since a linear search for each region would not finish in reasonable time
+class TreeSampleManager {
+public:
+    Sample* FindSample(const std::string& file) {
+        std::map<std::string, Sample*>::iterator it = samplesByFile.find(file);
+        return (it != samplesByFile.end()) ? it->second : NULL;
+    }
+
+    void AddSampleConsumer(Sample* pSample, Region* pConsumer) {
+        if (sampleMap.find(pSample) == sampleMap.end()) {
+            sampleMap[pSample];
+            samplesByFile[pSample->file] = pSample;
+        }
+        sampleMap[pSample].insert(pConsumer);
+    }
+
+    void RemoveSampleConsumer(Sample* pSample, Region* pConsumer) {
+        sampleMap[pSample].erase(pConsumer);
+    }
+
+    bool HasSampleConsumers(Sample* pSample) {
+        return !sampleMap[pSample].empty();
+    }
+
+    void RemoveSample(Sample* pSample) {
+        sampleMap.erase(pSample);
+        samplesByFile.erase(pSample->file);
+    }
+
+private:
+    std::map<Sample*, std::set<Region*> > sampleMap;
+    std::map<std::string, Sample*> samplesByFile;
+};
+
+static std::vector<std::string> files;
+static std::vector<Region> regions;
+
+template<class Manager>
+static void load(Manager& manager) {
+    for (size_t i = 0; i < regions.size(); i++) {
+        const std::string& file = files[i / REGIONS_PER_SAMPLE];
+        Sample* pSample = manager.FindSample(file);
+        if (!pSample) pSample = new Sample(file);
+        manager.AddSampleConsumer(pSample, &regions[i]);
+        regions[i].pSample = pSample;
+    }
+}
+
+template<class Manager>
+static void unload(Manager& manager) {
+    for (size_t i = 0; i < regions.size(); i++) {
+        Sample* pSample = regions[i].pSample;
+        manager.RemoveSampleConsumer(pSample, &regions[i]);
+        if (!manager.HasSampleConsumers(pSample)) {
+            manager.RemoveSample(pSample);
+            delete pSample;
+        }
+        regions[i].pSample = NULL;
+    }
+}
+
+template<class Manager>
+static void run(const char* name) {
+    double loadTime = 0, unloadTime = 0;
+    size_t bookkeeping = 0;
+    for (int i = 0; i < CYCLES; i++) {
+        Manager* pManager = new Manager;
+        const size_t heapBefore = heapUsage;
+        clock_t start_time = clock();
+        load(*pManager);
+        clock_t stop_time = clock();
+        loadTime += double(stop_time - start_time) / CLOCKS_PER_SEC * 1000.0;
+        // don't count the samples (and their file names) themselves
+        bookkeeping = heapUsage - heapBefore - SAMPLES * (sizeof(Sample) + files[0].size() + 1);
+        start_time = clock();
+        unload(*pManager);
+        stop_time = clock();
+        unloadTime += double(stop_time - start_time) / CLOCKS_PER_SEC * 1000.0;
+        delete pManager;
+    }
+    printf("%-20s load %1.0f ms, unload %1.0f ms, bookkeeping approx. %lu kB\n",
+           name, loadTime / CYCLES, unloadTime / CYCLES,
+           (unsigned long) (bookkeeping / 1024));
+}
+
+int main() {
+    char buf[256];
+    for (int i = 0; i < SAMPLES; i++) {
+        // long enough to not fit into the small string buffer of std::string
+        snprintf(buf, sizeof(buf), "Library/Instrument%05d/Samples/sample%07d.flac", i / 100, i);
+        files.push_back(buf);
+    }
+    regions.resize(SAMPLES * REGIONS_PER_SAMPLE);
+
+    printf("%d samples, %d regions, average of %d load/unload cycles\n",
+           SAMPLES, SAMPLES * REGIONS_PER_SAMPLE, CYCLES);
+    run<IndexedSampleManager>("SampleManager:");
+    run<TreeSampleManager>("std::map/std::set:");
+    return 0;
+}
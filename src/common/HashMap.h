@@ -0,0 +1,311 @@
+/***************************************************************************
+ *                                                                         *
+ *   LinuxSampler - modular, streaming capable sampler                     *
+ *                                                                         *
+ *   Copyright (C) 2026 The LinuxSampler Developers                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston,                 *
+ *   MA  02111-1307  USA                                                   *
+ ***************************************************************************/
+
+#ifndef __LS_HASHMAP_H__
+#define __LS_HASHMAP_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+
+namespace LinuxSampler {
+
+    /// Hash function for integers and pointers used by HashMap.
+    inline size_t HashOf(size_t x) {
+        x ^= x >> 16;
+        x *= 0x45d9f3b;
+        x ^= x >> 16;
+        x *= 0x45d9f3b;
+        x ^= x >> 16;
+        return x;
+    }
+
+    template<class T>
+    inline size_t HashOf(T* p) {
+        return HashOf(size_t(p) >> 3); // lowest bits are 0 due to alignment
+    }
+
+    /// FNV-1a hash of a string.
+    inline size_t HashOf(const std::string& s) {
+        size_t h = 2166136261u;
+        for (size_t i = 0; i < s.size(); i++) {
+            h ^= (unsigned char) s[i];
+            h *= 16777619u;
+        }
+        return h;
+    }
+
+    /**
+     * Unordered map with open addressing (linear probing). Intended for
+     * huge amounts of small entries like pointers, for which std::map would
+     * need a separately allocated tree node per entry. All entries are
+     * stored in one array instead, which is doubled when it's 3/4 full.
+     *
+     * There must be a HashOf() function for the key type K, and K and V
+     * must be default constructible. Values are moved with swap() when the
+     * array grows or an entry is removed, so V should provide a cheap
+     * swap() if it owns memory.
+     *
+     * Pointers returned by find() and references returned by operator[]
+     * are only valid until the next insertion or removal.
+     *
+     * This class is not thread safe and not real-time safe.
+     */
+    template<class K, class V>
+    class HashMap {
+    public:
+        HashMap() : slots(NULL), used(NULL), capacity(0), count(0) { }
+
+        ~HashMap() {
+            if (slots) delete[] slots;
+            if (used)  delete[] used;
+        }
+
+        /**
+         * Returns the value of the given key or NULL if there is no such
+         * entry.
+         */
+        V* find(const K& key) const {
+            if (!count) return NULL;
+            for (size_t i = HashOf(key) & (capacity - 1); used[i]; i = (i + 1) & (capacity - 1))
+                if (slots[i].key == key) return &slots[i].value;
+            return NULL;
+        }
+
+        /**
+         * Returns the value of the given key, a default constructed value
+         * is added first if there is no such entry yet.
+         */
+        V& operator[](const K& key) {
+            V* pValue = find(key);
+            if (pValue) return *pValue;
+            if ((count + 1) * 4 > capacity * 3) grow();
+            size_t i = HashOf(key) & (capacity - 1);
+            while (used[i]) i = (i + 1) & (capacity - 1);
+            used[i] = true;
+            slots[i].key = key;
+            count++;
+            return slots[i].value;
+        }
+
+        /**
+         * Removes the entry of the given key.
+         *
+         * @returns true if there was such an entry
+         */
+        bool erase(const K& key) {
+            if (!count) return false;
+            size_t i = HashOf(key) & (capacity - 1);
+            while (true) {
+                if (!used[i]) return false;
+                if (slots[i].key == key) break;
+                i = (i + 1) & (capacity - 1);
+            }
+            // close the gap by moving back following entries of the same
+            // probe sequence, so that lookups don't need tombstones
+            for (size_t j = (i + 1) & (capacity - 1); used[j]; j = (j + 1) & (capacity - 1)) {
+                const size_t home = HashOf(slots[j].key) & (capacity - 1);
+                // move entry j to i unless its home lies cyclically in (i,j]
+                const bool bStay = (i <= j) ? (i < home && home <= j)
+                                            : (i < home || home <= j);
+                if (bStay) continue;
+                slots[i].key = slots[j].key;
+                using std::swap;
+                swap(slots[i].value, slots[j].value);
+                i = j;
+            }
+            used[i] = false;
+            slots[i].key   = K();
+            slots[i].value = V();
+            count--;
+            return true;
+        }
+
+        size_t size() const { return count; }
+
+        bool empty() const { return !count; }
+
+        /**
+         * Returns the size of the memory allocated by this map itself (not
+         * including memory owned by the keys and values).
+         */
+        size_t memoryUsage() const {
+            return capacity * (sizeof(slot_t) + sizeof(bool));
+        }
+
+    private:
+        struct slot_t {
+            K key;
+            V value;
+        };
+
+        slot_t* slots;
+        bool*   used;
+        size_t  capacity; ///< always a power of two (or 0)
+        size_t  count;
+
+        void grow() {
+            slot_t* oldSlots    = slots;
+            bool*   oldUsed     = used;
+            size_t  oldCapacity = capacity;
+
+            capacity = (capacity) ? capacity * 2 : 16;
+            slots    = new slot_t[capacity];
+            used     = new bool[capacity];
+            memset(used, 0, capacity * sizeof(bool));
+
+            for (size_t k = 0; k < oldCapacity; k++) {
+                if (!oldUsed[k]) continue;
+                size_t i = HashOf(oldSlots[k].key) & (capacity - 1);
+                while (used[i]) i = (i + 1) & (capacity - 1);
+                used[i] = true;
+                slots[i].key = oldSlots[k].key;
+                using std::swap;
+                swap(slots[i].value, oldSlots[k].value);
+            }
+
+            if (oldSlots) delete[] oldSlots;
+            if (oldUsed)  delete[] oldUsed;
+        }
+
+        // not copyable
+        HashMap(const HashMap&);
+        HashMap& operator=(const HashMap&);
+    };
+
+    /**
+     * Set of pointers, of which the first one is stored inline and only
+     * further ones in a heap allocated vector, since most of such sets
+     * (e.g. the consumers of a sample) contain only one element. The order
+     * of the elements is not preserved on removal.
+     */
+    template<class T>
+    class SmallSet {
+    public:
+        SmallSet() : first(NULL), pMore(NULL), moreCount(0), moreCapacity(0) { }
+
+        SmallSet(const SmallSet& set) : first(NULL), pMore(NULL), moreCount(0), moreCapacity(0) {
+            *this = set;
+        }
+
+        ~SmallSet() {
+            if (pMore) delete[] pMore;
+        }
+
+        SmallSet& operator=(const SmallSet& set) {
+            if (&set == this) return *this;
+            clear();
+            if (set.first) insert(set.first);
+            for (uint32_t i = 0; i < set.moreCount; i++) insert(set.pMore[i]);
+            return *this;
+        }
+
+        bool empty() const { return !first; }
+
+        size_t size() const { return (first) ? 1 + moreCount : 0; }
+
+        T* operator[](size_t i) const { return (i) ? pMore[i - 1] : first; }
+
+        bool contains(T* p) const {
+            if (!p || !first) return false;
+            if (first == p) return true;
+            for (uint32_t i = 0; i < moreCount; i++)
+                if (pMore[i] == p) return true;
+            return false;
+        }
+
+        /**
+         * Adds @a p to the set.
+         *
+         * @returns false if @a p was already in the set
+         */
+        bool insert(T* p) {
+            if (!p || contains(p)) return false;
+            if (!first) {
+                first = p;
+                return true;
+            }
+            if (moreCount == moreCapacity) {
+                moreCapacity = (moreCapacity) ? moreCapacity * 2 : 2;
+                T** pNew = new T*[moreCapacity];
+                for (uint32_t i = 0; i < moreCount; i++) pNew[i] = pMore[i];
+                if (pMore) delete[] pMore;
+                pMore = pNew;
+            }
+            pMore[moreCount++] = p;
+            return true;
+        }
+
+        /**
+         * Removes @a p from the set.
+         *
+         * @returns true if @a p was in the set
+         */
+        bool erase(T* p) {
+            if (!p || !first) return false;
+            if (first == p) {
+                first = (moreCount) ? pMore[--moreCount] : NULL;
+            } else {
+                uint32_t i = 0;
+                while (i < moreCount && pMore[i] != p) i++;
+                if (i == moreCount) return false;
+                pMore[i] = pMore[--moreCount];
+            }
+            if (!moreCount && pMore) {
+                delete[] pMore;
+                pMore = NULL;
+                moreCapacity = 0;
+            }
+            return true;
+        }
+
+        void clear() {
+            first = NULL;
+            if (pMore) delete[] pMore;
+            pMore = NULL;
+            moreCount = moreCapacity = 0;
+        }
+
+        void swap(SmallSet& set) {
+            std::swap(first, set.first);
+            std::swap(pMore, set.pMore);
+            std::swap(moreCount, set.moreCount);
+            std::swap(moreCapacity, set.moreCapacity);
+        }
+
+    private:
+        T*       first;
+        T**      pMore;
+        uint32_t moreCount;
+        uint32_t moreCapacity;
+    };
+
+    template<class T>
+    inline void swap(SmallSet<T>& a, SmallSet<T>& b) {
+        a.swap(b);
+    }
+
+} // namespace LinuxSampler
+
+#endif // __LS_HASHMAP_H__
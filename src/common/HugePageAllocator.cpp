@@ -0,0 +1,367 @@
+/***************************************************************************
+ *                                                                         *
+ *   LinuxSampler - modular, streaming capable sampler                     *
+ *                                                                         *
+ *   Copyright (C) 2026 The LinuxSampler Developers                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston,                 *
+ *   MA  02111-1307  USA                                                   *
+ ***************************************************************************/
+
+#include "HugePageAllocator.h"
+#include "Mutex.h"
+#include "Thread.h"
+
+#include <new>
+#include <map>
+#include <vector>
+#include <stdio.h>
+#include <stdint.h>
+
+#if defined(__linux__)
+# include <sys/mman.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+#endif
+
+// memory policy of the mbind() system call, same value as in <numaif.h>,
+// defined here to avoid a dependency on libnuma
+#ifndef MPOL_PREFERRED
+# define MPOL_PREFERRED 1
+#endif
+
+// size of one huge page on x86 and most other architectures, buffers of at
+// least this size get their own mapping, smaller ones are carved out of
+// slabs of this size
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+// granularity of the allocations within a slab
+#define SLAB_ALIGNMENT 64
+
+namespace LinuxSampler {
+
+static Mutex allocatorMutex; ///< protects all of the following
+static size_t allocatedBytes = 0;
+static size_t hugePageBytes  = 0;
+static size_t numaBoundBytes = 0;
+
+struct mapping_t {
+    size_t len;
+    bool   bHugeTLB;
+    int    node; ///< NUMA node the mapping was bound to, -1 if not bound
+};
+static std::map<void*,mapping_t> mappings; ///< all memory mapped with mmap(), including the slabs
+
+#if defined(__linux__)
+static std::map<int8_t*,size_t> slabs; ///< start address of each slab -> amount of bytes allocated from it
+static std::map<int8_t*,size_t> freeBlocksByAddr; ///< unused ranges of all slabs: start address -> size
+static std::multimap<size_t,int8_t*> freeBlocksBySize; ///< same ranges, ordered by size
+
+static size_t mappedSize(size_t size) {
+    return (size + HUGE_PAGE_SIZE - 1) & ~size_t(HUGE_PAGE_SIZE - 1);
+}
+
+static size_t slabSize(size_t size) {
+    return (size + SLAB_ALIGNMENT - 1) & ~size_t(SLAB_ALIGNMENT - 1);
+}
+/**
+ * Returns the NUMA node the given CPU belongs to, or -1 if unknown.
+ */
+static int nodeOfCpu(int cpu) {
+    char path[64];
+    for (int node = 0; node < int(8 * sizeof(unsigned long)); ++node) {
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/node%d", cpu, node);
+        if (access(path, F_OK) == 0) return node;
+    }
+    return -1;
+}
+
+/**
+ * Returns the NUMA node memory should be placed on for the audio thread,
+ * that is the node of the first CPU the audio threads are pinned to.
+ * Returns -1 if the audio threads are not pinned or if this is not a NUMA
+ * system.
+ */
+static int audioNode() {
+    // nothing to gain on systems with only one node
+    if (access("/sys/devices/system/node/node1", F_OK) != 0) return -1;
+    std::vector<int> cpus = Thread::GetCpuAffinity(Thread::ROLE_AUDIO);
+    if (cpus.empty()) return -1;
+    return nodeOfCpu(cpus[0]);
+}
+
+/**
+ * Asks the kernel to preferably place the pages of the given mapping on
+ * NUMA node @a node. Must be called before the pages are touched the first
+ * time. Returns true on success.
+ */
+static bool bindToNode(void* p, size_t len, int node) {
+    #ifdef SYS_mbind
+    unsigned long mask = 1UL << node;
+    return syscall(SYS_mbind, p, len, MPOL_PREFERRED, &mask,
+                   8 * sizeof(mask) + 1, 0) == 0;
+    #else
+    return false;
+    #endif
+}
+
+/**
+ * Returns the amount of bytes of the given mapping which currently reside
+ * on another NUMA node than @a node. Only the location of the first page
+ * of each huge page is queried (the mappings are aligned to huge pages),
+ * which is exact for explicit huge pages and a good estimate otherwise.
+ */
+static size_t remoteBytes(void* p, size_t len, int node) {
+    #ifdef SYS_move_pages
+    const size_t nPages = len / HUGE_PAGE_SIZE;
+    std::vector<void*> pages(nPages);
+    std::vector<int> status(nPages);
+    for (size_t i = 0; i < nPages; ++i)
+        pages[i] = (int8_t*)p + i * HUGE_PAGE_SIZE;
+    // without target nodes, move_pages() just reports the current node
+    if (syscall(SYS_move_pages, 0, nPages, &pages[0], NULL, &status[0], 0) != 0)
+        return 0;
+    size_t remote = 0;
+    for (size_t i = 0; i < nPages; ++i)
+        if (status[i] >= 0 && status[i] != node) remote += HUGE_PAGE_SIZE;
+    return remote;
+    #else
+    return 0;
+    #endif
+}
+/**
+ * Maps @a len bytes (a multiple of HUGE_PAGE_SIZE), preferably on explicit
+ * huge pages, otherwise on regular pages aligned to huge page boundaries,
+ * so the kernel can back them with transparent huge pages. Returns NULL if
+ * no memory could be mapped. Caller must hold allocatorMutex.
+ */
+static void* mapPages(size_t len) {
+    bool bHugeTLB = false;
+    void* p = MAP_FAILED;
+    # ifdef MAP_HUGETLB
+    p = mmap(NULL, len, PROT_READ | PROT_WRITE,
+             MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    bHugeTLB = (p != MAP_FAILED);
+    # endif
+    if (p == MAP_FAILED) {
+        // no (or not enough) explicit huge pages reserved, fall back to
+        // regular pages, mapping one huge page more than needed to be able
+        // to cut out a huge page aligned range
+        int8_t* q = (int8_t*) mmap(NULL, len + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE,
+                                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (q == MAP_FAILED) return NULL;
+        int8_t* aligned = (int8_t*) (((uintptr_t)q + HUGE_PAGE_SIZE - 1) & ~uintptr_t(HUGE_PAGE_SIZE - 1));
+        if (aligned > q) munmap(q, aligned - q);
+        if (q + HUGE_PAGE_SIZE > aligned) munmap(aligned + len, q + HUGE_PAGE_SIZE - aligned);
+        p = aligned;
+        # ifdef MADV_HUGEPAGE
+        madvise(p, len, MADV_HUGEPAGE);
+        # endif
+    }
+    // place the buffer on the NUMA node of the audio thread, which is the
+    // one rendering from it
+    int node = audioNode();
+    if (node >= 0 && !bindToNode(p, len, node)) node = -1;
+    if (bHugeTLB) hugePageBytes += len;
+    if (node >= 0) numaBoundBytes += len;
+    mapping_t m = { len, bHugeTLB, node };
+    mappings[p] = m;
+    return p;
+}
+
+/**
+ * Unmaps memory mapped by mapPages(). Caller must hold allocatorMutex.
+ */
+static void unmapPages(void* p, size_t len) {
+    munmap(p, len);
+    std::map<void*,mapping_t>::iterator it = mappings.find(p);
+    if (it != mappings.end()) {
+        if (it->second.bHugeTLB) hugePageBytes -= len;
+        if (it->second.node >= 0) numaBoundBytes -= len;
+        mappings.erase(it);
+    }
+}
+
+static void addFreeBlock(int8_t* p, size_t len) {
+    freeBlocksByAddr[p] = len;
+    freeBlocksBySize.insert(std::make_pair(len, p));
+}
+
+static void removeFreeBlock(std::map<int8_t*,size_t>::iterator it) {
+    std::multimap<size_t,int8_t*>::iterator itSize = freeBlocksBySize.lower_bound(it->second);
+    while (itSize->second != it->first) ++itSize;
+    freeBlocksBySize.erase(itSize);
+    freeBlocksByAddr.erase(it);
+}
+
+/**
+ * Returns the slab containing @a p, or slabs.end() if @a p was not
+ * allocated from a slab. Caller must hold allocatorMutex.
+ */
+static std::map<int8_t*,size_t>::iterator slabOf(int8_t* p) {
+    std::map<int8_t*,size_t>::iterator it = slabs.upper_bound(p);
+    if (it == slabs.begin()) return slabs.end();
+    --it;
+    return (p < it->first + HUGE_PAGE_SIZE) ? it : slabs.end();
+}
+
+/**
+ * Allocates @a len bytes (a multiple of SLAB_ALIGNMENT smaller than
+ * HUGE_PAGE_SIZE) from the smallest free range of all slabs it fits into,
+ * mapping a new slab if none has enough room. Returns NULL if no memory
+ * could be mapped. Caller must hold allocatorMutex.
+ */
+static void* slabAllocate(size_t len) {
+    std::multimap<size_t,int8_t*>::iterator itSize = freeBlocksBySize.lower_bound(len);
+    int8_t* p;
+    if (itSize != freeBlocksBySize.end()) {
+        p = itSize->second;
+        const size_t blockLen = itSize->first;
+        removeFreeBlock(freeBlocksByAddr.find(p));
+        if (blockLen > len) addFreeBlock(p + len, blockLen - len);
+    } else {
+        p = (int8_t*) mapPages(HUGE_PAGE_SIZE);
+        if (!p) return NULL;
+        slabs[p] = 0;
+        addFreeBlock(p + len, HUGE_PAGE_SIZE - len);
+    }
+    slabOf(p)->second += len;
+    return p;
+}
+
+/**
+ * Gives @a len bytes at @a p back to the slab @a itSlab, merging the range
+ * with adjacent free ranges of the same slab, and unmaps the slab if it
+ * became completely unused. Caller must hold allocatorMutex.
+ */
+static void slabFree(std::map<int8_t*,size_t>::iterator itSlab, int8_t* p, size_t len) {
+    int8_t* slabStart = itSlab->first;
+    itSlab->second -= len;
+    if (!itSlab->second) {
+        // the rest of the slab is already free, that is one single range
+        // (or none, if this was the only allocation covering the whole slab)
+        std::map<int8_t*,size_t>::iterator it = freeBlocksByAddr.lower_bound(slabStart);
+        while (it != freeBlocksByAddr.end() && it->first < slabStart + HUGE_PAGE_SIZE) {
+            std::map<int8_t*,size_t>::iterator itBlock = it++;
+            removeFreeBlock(itBlock);
+        }
+        slabs.erase(itSlab);
+        unmapPages(slabStart, HUGE_PAGE_SIZE);
+        return;
+    }
+    std::map<int8_t*,size_t>::iterator itNext = freeBlocksByAddr.lower_bound(p);
+    if (itNext != freeBlocksByAddr.end() && itNext->first == p + len) {
+        len += itNext->second;
+        removeFreeBlock(itNext);
+    }
+    std::map<int8_t*,size_t>::iterator itPrev = freeBlocksByAddr.lower_bound(p);
+    if (itPrev != freeBlocksByAddr.begin()) {
+        --itPrev;
+        if (itPrev->first >= slabStart && itPrev->first + itPrev->second == p) {
+            p = itPrev->first;
+            len += itPrev->second;
+            removeFreeBlock(itPrev);
+        }
+    }
+    addFreeBlock(p, len);
+}
+#endif
+
+void* HugePageAllocator::Allocate(size_t size) {
+    if (!size) size = 1;
+    #if defined(__linux__)
+    {
+        LockGuard lock(allocatorMutex);
+        if (size >= HUGE_PAGE_SIZE) {
+            const size_t len = mappedSize(size);
+            void* p = mapPages(len);
+            if (p) allocatedBytes += len;
+            return p;
+        }
+        const size_t len = slabSize(size);
+        void* p = slabAllocate(len);
+        if (p) {
+            allocatedBytes += len;
+            return p;
+        }
+    }
+    // no memory could be mapped at all, try the heap instead
+    #endif
+    void* p = new(std::nothrow) int8_t[size];
+    if (p) {
+        LockGuard lock(allocatorMutex);
+        allocatedBytes += size;
+    }
+    return p;
+}
+
+void HugePageAllocator::Free(void* p, size_t size) {
+    if (!p) return;
+    if (!size) size = 1;
+    #if defined(__linux__)
+    {
+        LockGuard lock(allocatorMutex);
+        if (size >= HUGE_PAGE_SIZE) {
+            const size_t len = mappedSize(size);
+            unmapPages(p, len);
+            allocatedBytes -= len;
+            return;
+        }
+        std::map<int8_t*,size_t>::iterator itSlab = slabOf((int8_t*)p);
+        if (itSlab != slabs.end()) {
+            const size_t len = slabSize(size);
+            slabFree(itSlab, (int8_t*)p, len);
+            allocatedBytes -= len;
+            return;
+        }
+    }
+    #endif
+    delete[] (int8_t*) p;
+    LockGuard lock(allocatorMutex);
+    allocatedBytes -= size;
+}
+
+HugePageAllocator::statistics_t HugePageAllocator::GetStatistics() {
+    statistics_t stats;
+    std::vector< std::pair<void*,size_t> > snapshot;
+    {
+        LockGuard lock(allocatorMutex);
+        stats.AllocatedBytes = allocatedBytes;
+        stats.HugePageBytes  = hugePageBytes;
+        stats.NumaBoundBytes = numaBoundBytes;
+        #if defined(__linux__)
+        snapshot.reserve(mappings.size());
+        for (std::map<void*,mapping_t>::iterator it = mappings.begin();
+             it != mappings.end(); ++it)
+        {
+            snapshot.push_back(std::make_pair(it->first, it->second.len));
+        }
+        #endif
+    }
+    stats.NumaRemoteBytes = 0;
+    #if defined(__linux__)
+    // query the page locations without holding the lock, so allocations
+    // are not blocked meanwhile; a mapping freed in the meantime is
+    // reported as not present by move_pages() and thus not counted
+    const int node = audioNode();
+    if (node >= 0) {
+        for (size_t i = 0; i < snapshot.size(); ++i)
+            stats.NumaRemoteBytes += remoteBytes(snapshot[i].first, snapshot[i].second, node);
+    }
+    #endif
+    return stats;
+}
+
+} // namespace LinuxSampler
@@ -0,0 +1,87 @@
+/***************************************************************************
+ *                                                                         *
+ *   LinuxSampler - modular, streaming capable sampler                     *
+ *                                                                         *
+ *   Copyright (C) 2026 The LinuxSampler Developers                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston,                 *
+ *   MA  02111-1307  USA                                                   *
+ ***************************************************************************/
+
+#ifndef LS_HUGEPAGEALLOCATOR_H
+#define LS_HUGEPAGEALLOCATOR_H
+
+#include <stddef.h>
+
+namespace LinuxSampler {
+
+/**
+ * Allocates large buffers (i.e. disk stream buffers and sample RAM caches)
+ * preferably on huge pages, to reduce TLB misses when the audio thread
+ * accesses many large buffers at random.
+ *
+ * Memory is first tried to be mapped on explicit huge pages (MAP_HUGETLB,
+ * requires huge pages being reserved by the system administrator). If that
+ * fails, regular anonymous memory aligned to huge page boundaries is mapped
+ * and the kernel is advised to back it with transparent huge pages instead.
+ * Buffers of at least 2 MB get their own mapping, rounded up to whole huge
+ * pages. Smaller buffers (e.g. the RAM caches of most samples) are carved
+ * out of shared slabs of one huge page each, and a slab is unmapped again
+ * once all of its buffers were freed. Systems other than Linux simply use
+ * the heap.
+ *
+ * On NUMA systems, if the audio threads are pinned to certain CPUs (see
+ * Thread::SetCpuAffinity()), mapped buffers are preferably placed on the
+ * memory node of those CPUs, since the audio thread is the one reading
+ * them most of the time. Affinity changes only affect buffers allocated
+ * afterwards.
+ *
+ * This is not real-time safe, so it must not be used by the audio thread.
+ *
+ * @e Note: this class is not exported to the C++ API of the sampler!
+ */
+class HugePageAllocator {
+public:
+    struct statistics_t {
+        size_t AllocatedBytes; ///< Total size of all buffers currently allocated by this class.
+        size_t HugePageBytes;  ///< Size of the memory mapped on explicit huge pages (including unused parts of slabs).
+        size_t NumaBoundBytes; ///< Size of the memory which was bound to the NUMA node of the audio thread (including unused parts of slabs).
+        size_t NumaRemoteBytes; ///< Size of the pages of all mapped buffers which currently reside on another NUMA node than the audio thread's one.
+    };
+
+    /**
+     * Allocates a buffer of at least @a size bytes. Returns NULL if no
+     * memory could be allocated.
+     */
+    static void* Allocate(size_t size);
+
+    /**
+     * Frees a buffer previously allocated with Allocate(). @a size must be
+     * the same size which was passed to Allocate().
+     */
+    static void Free(void* p, size_t size);
+
+    /**
+     * Returns the amount of memory currently allocated by this class.
+     * Determining NumaRemoteBytes requires to query the location of each
+     * huge page (without blocking allocations meanwhile), so don't call
+     * this too often.
+     */
+    static statistics_t GetStatistics();
+};
+
+} // namespace LinuxSampler
+
+#endif // LS_HUGEPAGEALLOCATOR_H
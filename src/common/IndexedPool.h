@@ -0,0 +1,888 @@
+/***************************************************************************
+ *                                                                         *
+ *   LinuxSampler - modular, streaming capable sampler                     *
+ *                                                                         *
+ *   Copyright (C) 2026 The LinuxSampler Developers                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston,                 *
+ *   MA  02111-1307  USA                                                   *
+ ***************************************************************************/
+
+#ifndef __LS_INDEXEDPOOL_H__
+#define __LS_INDEXEDPOOL_H__
+
+// This file is only included by Pool.h if CONFIG_INDEXED_POOL is enabled,
+// it provides the same Pool, RTList and Iterator API as the pointer based
+// implementation in Pool.h, but links elements by 32 bit indices instead
+// of pointers:
+//
+// - The nodes of a pool (next, prev and reincarnation) are 12 bytes each
+//   instead of 32 bytes (on 64 bit systems) and the data pointer per node
+//   is gone, elements are addressed by their index into the pool's
+//   contiguous data array instead.
+//
+// - The boundary nodes of lists are not part of the list objects, they
+//   are allocated pairwise from a global arena instead, so that they can
+//   be addressed by indices as well. Indices of boundary nodes are marked
+//   by POOL_SENTINEL_FLAG.
+
+#include <iostream>
+#include <stdexcept>
+#include "Mutex.h"
+
+/// Index of a node of a Pool, or of a boundary node of a list.
+typedef uint32_t pool_link_t;
+
+#define POOL_SENTINEL_FLAG          0x80000000u
+#define POOL_INVALID_LINK           0xffffffffu
+#define POOL_SENTINEL_CHUNK_BITS    8
+#define POOL_SENTINEL_CHUNK_SIZE    (1 << POOL_SENTINEL_CHUNK_BITS)
+#define POOL_SENTINEL_CHUNKS        4096
+
+struct _PoolLink {
+    pool_link_t next;
+    pool_link_t prev;
+    #if CONFIG_DEVMODE
+    const void* list; // list to which this node currently belongs to
+    #endif // CONFIG_DEVMODE
+};
+
+/**
+ * Global arena for the boundary nodes of all lists. Memory is allocated in
+ * chunks which are never moved or freed, so the real-time thread can
+ * resolve the index of a boundary node without locking while other threads
+ * create or destroy lists.
+ */
+template<int Dummy = 0>
+class _PoolSentinelArena {
+    public:
+        static inline _PoolLink* link(pool_link_t i) {
+            i &= ~POOL_SENTINEL_FLAG;
+            return &chunks[i >> POOL_SENTINEL_CHUNK_BITS][i & (POOL_SENTINEL_CHUNK_SIZE - 1)];
+        }
+
+        /// Returns the index of the first of two consecutive boundary nodes.
+        static pool_link_t allocPair() {
+            LinuxSampler::LockGuard lock(mutex());
+            if (freePairs != POOL_INVALID_LINK) {
+                const pool_link_t i = freePairs;
+                freePairs = link(i)->next;
+                return i;
+            }
+            if (used + 2 > POOL_SENTINEL_CHUNKS * POOL_SENTINEL_CHUNK_SIZE)
+                throw std::runtime_error("Pool: too many lists");
+            if (!(used & (POOL_SENTINEL_CHUNK_SIZE - 1)))
+                chunks[used >> POOL_SENTINEL_CHUNK_BITS] = new _PoolLink[POOL_SENTINEL_CHUNK_SIZE];
+            const pool_link_t i = used | POOL_SENTINEL_FLAG;
+            used += 2;
+            return i;
+        }
+
+        static void freePair(pool_link_t i) {
+            LinuxSampler::LockGuard lock(mutex());
+            link(i)->next = freePairs;
+            freePairs = i;
+        }
+
+    private:
+        static LinuxSampler::Mutex& mutex() {
+            static LinuxSampler::Mutex m;
+            return m;
+        }
+
+        static _PoolLink*  chunks[POOL_SENTINEL_CHUNKS];
+        static pool_link_t freePairs; ///< singly linked list of unused pairs
+        static uint        used;      ///< amount of boundary nodes ever allocated
+};
+
+template<int Dummy> _PoolLink*  _PoolSentinelArena<Dummy>::chunks[POOL_SENTINEL_CHUNKS];
+template<int Dummy> pool_link_t _PoolSentinelArena<Dummy>::freePairs = POOL_INVALID_LINK;
+template<int Dummy> uint        _PoolSentinelArena<Dummy>::used = 0;
+
+typedef _PoolSentinelArena<> PoolSentinels;
+
+template<typename T>
+class RTListBase {
+    protected:
+        struct Node : _PoolLink {
+            uint reincarnation; // just for Pool::fromID()
+
+            Node() {
+                next = POOL_INVALID_LINK;
+                prev = POOL_INVALID_LINK;
+                #if CONFIG_DEVMODE
+                list = NULL;
+                #endif // CONFIG_DEVMODE
+                reincarnation = 0;
+            }
+
+            inline void bumpReincarnation(uint bits) {
+                reincarnation++;
+                // constrain the bitrange of "reincarnation", because Pool::fromID() will shift up/down for pool_element_id_t and compare this bitwise
+                reincarnation &= ((1 << bits) - 1);
+            }
+        };
+
+        /// Returns the node (or boundary node) reflected by index @a i.
+        static inline _PoolLink* link(const Pool<T>* pool, pool_link_t i) {
+            if (i & POOL_SENTINEL_FLAG) return PoolSentinels::link(i);
+            return &pool->nodes[i];
+        }
+
+    public:
+        /**
+         * Pointer-like object which allows to iterate over elements of a RTList,
+         * similar to iterators of STL container classes. Note that the main
+         * purpose of this class is to access elements of a list / pool i.e.
+         * within a @c while() loop. If you rather want to keep a reference to
+         * one particular element (i.e. for longer time) then you might
+         * consider using @c pool_element_id_t variables instead.
+         */
+        template<typename T1>
+        class _Iterator {
+            public:
+                _Iterator() {
+                    pool     = NULL;
+                    current  = POOL_INVALID_LINK;
+                    fallback = POOL_INVALID_LINK;
+                    #if CONFIG_DEVMODE
+                    list = NULL;
+                    #endif // CONFIG_DEVMODE
+                }
+
+                /// prefix increment op.
+                inline _Iterator& operator++() {
+                    #if CONFIG_DEVMODE
+                    if (!isValid()) {
+                        #if CONFIG_RT_EXCEPTIONS
+                        throw std::runtime_error(__err_msg_iterator_invalidated);
+                        #else
+                        std::cerr << __err_msg_iterator_invalidated << std::endl << std::flush;
+                        return *(_Iterator*)NULL; // force segfault if iterator became invalidated
+                        #endif // CONFIG_RT_EXCEPTIONS
+                    }
+                    #endif // CONFIG_DEVMODE
+                    fallback = current;
+                    current  = RTListBase<T1>::link(pool, current)->next;
+                    return *this;
+                }
+
+                /// postfix increment op.
+                inline _Iterator operator++(int) {
+                    _Iterator preval = *this;
+                    ++*this; // use prefix operator implementation
+                    return preval;
+                }
+
+                /// prefix decrement op.
+                inline _Iterator& operator--() {
+                    #if CONFIG_DEVMODE
+                    if (!isValid()) {
+                        #if CONFIG_RT_EXCEPTIONS
+                        throw std::runtime_error(__err_msg_iterator_invalidated);
+                        #else
+                        std::cerr << __err_msg_iterator_invalidated << std::endl << std::flush;
+                        return *(_Iterator*)NULL; // force segfault if iterator became invalidated
+                        #endif // CONFIG_RT_EXCEPTIONS
+                    }
+                    #endif // CONFIG_DEVMODE
+                    fallback = current;
+                    current  = RTListBase<T1>::link(pool, current)->prev;
+                    return *this;
+                }
+
+                /// postfix decrement op.
+                inline _Iterator operator--(int) {
+                    _Iterator preval = *this;
+                    --*this; // use prefix operator implementation
+                    return preval;
+                }
+
+                inline T1& operator*() {
+                    #if CONFIG_DEVMODE
+                    if (!isValid()) { // if iterator became invalidated
+                        #if CONFIG_RT_EXCEPTIONS
+                        throw std::runtime_error(__err_msg_iterator_invalidated);
+                        #else
+                        std::cerr << __err_msg_iterator_invalidated << std::endl << std::flush;
+                        return *((T1*)NULL); // force segfault if iterator became invalidated
+                        #endif // CONFIG_RT_EXCEPTIONS
+                    }
+                    #endif // CONFIG_DEVMODE
+                    return pool->data[current];
+                }
+
+                inline const T1& operator*() const {
+                    #if CONFIG_DEVMODE
+                    if (!isValid()) { // if iterator became invalidated
+                        #if CONFIG_RT_EXCEPTIONS
+                        throw std::runtime_error(__err_msg_iterator_invalidated);
+                        #else
+                        std::cerr << __err_msg_iterator_invalidated << std::endl << std::flush;
+                        return *((const T1*)NULL); // force segfault if iterator became invalidated
+                        #endif // CONFIG_RT_EXCEPTIONS
+                    }
+                    #endif // CONFIG_DEVMODE
+                    return pool->data[current];
+                }
+
+                inline T1* operator->() {
+                    #if CONFIG_DEVMODE
+                    if (!isValid()) { // if iterator became invalidated
+                        #if CONFIG_RT_EXCEPTIONS
+                        throw std::runtime_error(__err_msg_iterator_invalidated);
+                        #else
+                        std::cerr << __err_msg_iterator_invalidated << std::endl << std::flush;
+                        return (T1*)NULL; // force segfault if iterator became invalidated
+                        #endif // CONFIG_RT_EXCEPTIONS
+                    }
+                    #endif // CONFIG_DEVMODE
+                    return &pool->data[current];
+                }
+
+                inline const T1* operator->() const {
+                    #if CONFIG_DEVMODE
+                    if (!isValid()) { // if iterator became invalidated
+                        #if CONFIG_RT_EXCEPTIONS
+                        throw std::runtime_error(__err_msg_iterator_invalidated);
+                        #else
+                        std::cerr << __err_msg_iterator_invalidated << std::endl << std::flush;
+                        return (const T1*)NULL; // force segfault if iterator became invalidated
+                        #endif // CONFIG_RT_EXCEPTIONS
+                    }
+                    #endif // CONFIG_DEVMODE
+                    return &pool->data[current];
+                }
+
+                // boundary node indices are globally unique and comparing
+                // elements of different pools makes no sense, so comparing
+                // the index is sufficient
+                inline bool operator==(const _Iterator<T1> other) const {
+                    return current == other.current;
+                }
+
+                inline bool operator!=(const _Iterator<T1> other) const {
+                    return current != other.current;
+                }
+
+                inline operator bool() const {
+                    return !(current & POOL_SENTINEL_FLAG);
+                }
+
+                inline bool operator!() const {
+                    return current & POOL_SENTINEL_FLAG;
+                }
+
+                /**
+                 * Moves the element pointed by this Iterator from its current
+                 * list to the end of the destination list @a pDstList.
+                 *
+                 * @b CAUTION: When this method returns, this Iterator does
+                 * @b NOT point to the element on the new list anymore, instead it
+                 * points at a completely different element! In case of a
+                 * forward Iterator this Iterator object will point to the
+                 * previous element on the source list, in case of a backward
+                 * Iterator it will point to the subsequent element on the
+                 * source list. This behavior is enforced to avoid breaking an
+                 * active loop code working with this Iterator object.
+                 *
+                 * Thus if you intend to continue working with the same element,
+                 * you should do like this:
+                 * @code
+                 * it = it.moveToEndOf(anotherList);
+                 * @endcode
+                 *
+                 * @param pDstList - destination list
+                 * @returns Iterator object pointing at the moved element on
+                 *          the destination list
+                 */
+                inline _Iterator moveToEndOf(RTListBase<T1>* pDstList) {
+                    detach();
+                    pDstList->append(*this);
+                    _Iterator iterOnDstList = _Iterator(pool, current);
+                    current = fallback;
+                    return iterOnDstList;
+                }
+
+                /**
+                 * Moves the element pointed by this Iterator from its current
+                 * list to the beginning of the destination list @a pDstList.
+                 *
+                 * @b CAUTION: see moveToEndOf()
+                 *
+                 * @param pDstList - destination list
+                 * @returns Iterator object pointing at the moved element on
+                 *          the destination list
+                 */
+                inline _Iterator moveToBeginOf(RTListBase<T1>* pDstList) {
+                    detach();
+                    pDstList->prepend(*this);
+                    _Iterator iterOnDstList = _Iterator(pool, current);
+                    current = fallback;
+                    return iterOnDstList;
+                }
+
+                /**
+                 * Moves the element pointed by this Iterator from its current
+                 * position to the position right before @a itDst. That move
+                 * may either be from and to the same list, or to a another
+                 * list.
+                 *
+                 * @b CAUTION: see moveToEndOf()
+                 *
+                 * @param itDst - destination element to be inserted before
+                 * @returns Iterator object pointing at the moved element on
+                 *          the destination list
+                 */
+                inline _Iterator moveBefore(_Iterator<T1> itDst) {
+                    detach();
+                    RTList<T1>::prependBefore(*this, itDst);
+                    _Iterator iterOnDstList = _Iterator(pool, current);
+                    current = fallback;
+                    return iterOnDstList;
+                }
+
+                /**
+                 * Moves the element pointed by this Iterator from its current
+                 * position to the position right after @a itDst. That move
+                 * may either be from and to the same list, or to a another
+                 * list.
+                 *
+                 * @b CAUTION: see moveToEndOf()
+                 *
+                 * @param itDst - destination element to be inserted after
+                 * @returns Iterator object pointing at the moved element on
+                 *          the destination list
+                 */
+                inline _Iterator moveAfter(_Iterator<T1> itDst) {
+                    detach();
+                    RTList<T1>::appendAfter(*this, itDst);
+                    _Iterator iterOnDstList = _Iterator(pool, current);
+                    current = fallback;
+                    return iterOnDstList;
+                }
+
+                #if CONFIG_DEVMODE
+                inline bool isValid() const {
+                    return RTListBase<T1>::link(pool, current)->list == list;
+                }
+                #endif // CONFIG_DEVMODE
+
+            protected:
+                Pool<T1>*   pool;
+                pool_link_t current;
+                pool_link_t fallback;
+                enum dir_t {
+                    dir_forward,
+                    dir_backward
+                };
+                #if CONFIG_DEVMODE
+                const void* list;
+                #endif // CONFIG_DEVMODE
+
+                _Iterator(Pool<T1>* pool, pool_link_t i, dir_t direction = dir_forward) {
+                    const _PoolLink* pLink = RTListBase<T1>::link(pool, i);
+                    this->pool = pool;
+                    current  = i;
+                    fallback = (direction == dir_forward) ? pLink->prev : pLink->next;
+                    #if CONFIG_DEVMODE
+                    list = pLink->list;
+                    #endif // CONFIG_DEVMODE
+                }
+
+                inline pool_link_t index() const {
+                    #if CONFIG_DEVMODE
+                    #if CONFIG_RT_EXCEPTIONS
+                    if (isValid()) return current;
+                    else throw std::runtime_error(__err_msg_iterator_invalidated);
+                    #else
+                    return (isValid()) ? current : POOL_INVALID_LINK; // force segfault if iterator became invalidated
+                    #endif // CONFIG_RT_EXCEPTIONS
+                    #else
+                    return current;
+                    #endif // CONFIG_DEVMODE
+                }
+
+                inline _PoolLink* link() const {
+                    return RTListBase<T1>::link(pool, index());
+                }
+
+                inline void detach() {
+                    RTListBase<T1>::detach(*this);
+                }
+
+                friend class RTListBase<T1>;
+                friend class RTList<T1>;
+                friend class Pool<T1>;
+        };
+        typedef _Iterator<T> Iterator;
+
+        inline Iterator first() {
+            return Iterator(pPool, PoolSentinels::link(_begin)->next, Iterator::dir_forward);
+        }
+
+        inline Iterator last() {
+            return Iterator(pPool, PoolSentinels::link(_end)->prev, Iterator::dir_backward);
+        }
+
+        inline Iterator begin() {
+            return Iterator(pPool, _begin, Iterator::dir_forward);
+        }
+
+        inline Iterator end() {
+            return Iterator(pPool, _end, Iterator::dir_backward);
+        }
+
+        inline bool isEmpty() const {
+            return PoolSentinels::link(_begin)->next == _end;
+        }
+
+        inline int count() {
+            int elements = 0;
+            for (Iterator it = first(); it != end(); ++it) ++elements;
+            return elements;
+        }
+
+    protected:
+        Pool<T>*    pPool;  // pool the elements of this list are allocated from
+        pool_link_t _begin; // boundary node (without data) which represents the begin of the list - not the first element!
+        pool_link_t _end;   // boundary node (without data) which represents the end of the list - not the last element!
+
+        RTListBase(Pool<T>* pPool) {
+            this->pPool = pPool;
+            _begin = PoolSentinels::allocPair();
+            _end   = _begin + 1;
+            init();
+        }
+
+        ~RTListBase() {
+            PoolSentinels::freePair(_begin);
+        }
+
+        void init() {
+            // initialize boundary nodes
+            _PoolLink* begin = PoolSentinels::link(_begin);
+            _PoolLink* end   = PoolSentinels::link(_end);
+            begin->prev = _begin;
+            begin->next = _end;
+            end->next   = _end;
+            end->prev   = _begin;
+            #if CONFIG_DEVMODE
+            begin->list = this;
+            end->list   = this;
+            #endif // CONFIG_DEVMODE
+        }
+
+        inline void append(Iterator itElement) {
+            const pool_link_t i = itElement.current;
+            _PoolLink* pNode = link(itElement.pool, i);
+            _PoolLink* end   = PoolSentinels::link(_end);
+            const pool_link_t last = end->prev;
+            link(itElement.pool, last)->next = i;
+            pNode->prev = last; // if a segfault happens here, then because 'itElement' Iterator became invalidated
+            pNode->next = _end;
+            end->prev   = i;
+            #if CONFIG_DEVMODE
+            pNode->list = this;
+            #endif // CONFIG_DEVMODE
+        }
+
+        inline void append(Iterator itFirst, Iterator itLast) {
+            Pool<T>* pool = itFirst.pool;
+            const pool_link_t first = itFirst.current;
+            const pool_link_t last  = itLast.current;
+            _PoolLink* end = PoolSentinels::link(_end);
+            const pool_link_t oldLast = end->prev;
+            link(pool, oldLast)->next = first;
+            link(pool, first)->prev   = oldLast; // if a segfault happens here, then because 'itFirst' Iterator became invalidated
+            link(pool, last)->next    = _end;    // if a segfault happens here, then because 'itLast' Iterator became invalidated
+            end->prev = last;
+            #if CONFIG_DEVMODE
+            for (pool_link_t i = first; true; i = link(pool, i)->next) {
+                link(pool, i)->list = this;
+                if (i == last) break;
+            }
+            #endif // CONFIG_DEVMODE
+        }
+
+        inline void prepend(Iterator itElement) {
+            const pool_link_t i = itElement.current;
+            _PoolLink* pNode = link(itElement.pool, i);
+            _PoolLink* begin = PoolSentinels::link(_begin);
+            const pool_link_t first = begin->next;
+            begin->next = i;
+            pNode->prev = _begin; // if a segfault happens here, then because 'itElement' Iterator became invalidated
+            pNode->next = first;
+            link(itElement.pool, first)->prev = i;
+            #if CONFIG_DEVMODE
+            pNode->list = this;
+            #endif // CONFIG_DEVMODE
+        }
+
+        inline void prepend(Iterator itFirst, Iterator itLast) {
+            Pool<T>* pool = itFirst.pool;
+            const pool_link_t first = itFirst.current;
+            const pool_link_t last  = itLast.current;
+            _PoolLink* begin = PoolSentinels::link(_begin);
+            const pool_link_t oldFirst = begin->next;
+            begin->next = first;
+            link(pool, first)->prev    = _begin;   // if a segfault happens here, then because 'itFirst' Iterator became invalidated
+            link(pool, last)->next     = oldFirst; // if a segfault happens here, then because 'itLast' Iterator became invalidated
+            link(pool, oldFirst)->prev = last;
+            #if CONFIG_DEVMODE
+            for (pool_link_t i = first; true; i = link(pool, i)->next) {
+                link(pool, i)->list = this;
+                if (i == last) break;
+            }
+            #endif // CONFIG_DEVMODE
+        }
+
+        static inline void prependBefore(Iterator itSrc, Iterator itDst) {
+            Pool<T>* pool = itSrc.pool;
+            const pool_link_t src = itSrc.current;
+            const pool_link_t dst = itDst.current;
+            _PoolLink* pSrc = link(pool, src);
+            _PoolLink* pDst = link(pool, dst);
+            const pool_link_t prev = pDst->prev;
+            link(pool, prev)->next = src;
+            pDst->prev = src;
+            pSrc->prev = prev;
+            pSrc->next = dst;
+            #if CONFIG_DEVMODE
+            pSrc->list = pDst->list;
+            #endif // CONFIG_DEVMODE
+        }
+
+        static inline void appendAfter(Iterator itSrc, Iterator itDst) {
+            Pool<T>* pool = itSrc.pool;
+            const pool_link_t src = itSrc.current;
+            const pool_link_t dst = itDst.current;
+            _PoolLink* pSrc = link(pool, src);
+            _PoolLink* pDst = link(pool, dst);
+            const pool_link_t next = pDst->next;
+            link(pool, next)->prev = src;
+            pDst->next = src;
+            pSrc->prev = dst;
+            pSrc->next = next;
+            #if CONFIG_DEVMODE
+            pSrc->list = pDst->list;
+            #endif // CONFIG_DEVMODE
+        }
+
+        static inline void detach(Iterator itElement) {
+            Pool<T>* pool = itElement.pool;
+            _PoolLink* pNode = itElement.link();
+            const pool_link_t prev = pNode->prev; // if a segfault happens here, then because 'itElement' Iterator became invalidated
+            const pool_link_t next = pNode->next;
+            link(pool, prev)->next = next;
+            link(pool, next)->prev = prev;
+        }
+
+        static inline void detach(Iterator itFirst, Iterator itLast) {
+            Pool<T>* pool = itFirst.pool;
+            const pool_link_t prev = itFirst.link()->prev; // if a segfault happens here, then because 'itFirst' Iterator became invalidated
+            const pool_link_t next = itLast.link()->next;  // if a segfault happens here, then because 'itLast' Iterator became invalidated
+            link(pool, prev)->next = next;
+            link(pool, next)->prev = prev;
+        }
+
+        friend class _Iterator<T>;
+        friend class RTList<T>;
+        friend class Pool<T>;
+};
+
+template<typename T>
+class RTList : public RTListBase<T> {
+    public:
+        typedef typename RTListBase<T>::Node     Node;
+        typedef typename RTListBase<T>::Iterator Iterator;
+
+        /**
+         * Constructor
+         *
+         * @param pPool - pool this list uses for allocation and
+         *                deallocation of elements
+         */
+        RTList(Pool<T>* pPool) : RTListBase<T>::RTListBase(pPool) {
+        }
+
+        /**
+         * Copy constructor
+         */
+        RTList(RTList<T>& list) : RTListBase<T>::RTListBase(list.pPool) {
+            Iterator it = list.first();
+            Iterator end = list.end();
+            for(; it != end; ++it) {
+                if (poolIsEmpty()) break;
+                *(allocAppend()) = *it;
+            }
+        }
+
+        virtual ~RTList() {
+            clear();
+        }
+
+        inline bool poolIsEmpty() const {
+            return this->pPool->poolIsEmpty();
+        }
+
+        inline Iterator allocAppend() {
+            if (this->pPool->poolIsEmpty()) return RTListBase<T>::begin();
+            Iterator element = this->pPool->alloc();
+            this->append(element);
+            #if CONFIG_DEVMODE
+            element.list = static_cast<RTListBase<T>*>(this);
+            #endif // CONFIG_DEVMODE
+            return element;
+        }
+
+        inline Iterator allocPrepend() {
+            if (this->pPool->poolIsEmpty()) return RTListBase<T>::end();
+            Iterator element = this->pPool->alloc();
+            this->prepend(element);
+            #if CONFIG_DEVMODE
+            element.list = static_cast<RTListBase<T>*>(this);
+            #endif // CONFIG_DEVMODE
+            return element;
+        }
+
+        inline void free(Iterator& itElement) {
+            itElement.detach();
+            this->pPool->freeToPool(itElement);
+            itElement.current = itElement.fallback;
+        }
+
+        inline void clear() {
+            if (!RTListBase<T>::isEmpty()) {
+                Iterator first = RTListBase<T>::first();
+                Iterator last  = RTListBase<T>::last();
+                RTListBase<T>::detach(first, last);
+                this->pPool->freeToPool(first, last);
+            }
+        }
+
+        inline pool_element_id_t getID(const T* obj) const {
+            return this->pPool->getID(obj);
+        }
+
+        inline pool_element_id_t getID(const Iterator& it) const {
+            return this->pPool->getID(&*it);
+        }
+
+        inline Iterator fromID(pool_element_id_t id) const {
+            return this->pPool->fromID(id);
+        }
+
+        inline Iterator fromPtr(const T* obj) const {
+            return this->pPool->fromPtr(obj);
+        }
+};
+
+template<typename T>
+class Pool : public RTList<T> {
+    public:
+        typedef typename RTList<T>::Node     Node;
+        typedef typename RTList<T>::Iterator Iterator;
+
+        Node*         nodes;
+        T*            data;
+        RTListBase<T> freelist; // not yet allocated elements
+        uint          poolsize;
+        // following 3 used for element ID generation (and vice versa)
+        uint          poolsizebits; ///< Amount of bits required to index all elements of this pool (according to current pool size).
+        uint          reservedbits; ///< 3rd party reserved bits on the left side of id (default: 0).
+        uint          reincarnationbits; ///< Amount of bits allowed for reincarnation counter.
+
+        Pool(int Elements) : RTList<T>::RTList(this), freelist(this), reservedbits(0) {
+            _init(Elements);
+        }
+
+        virtual ~Pool() {
+            // the list of the pool itself is destroyed after this, so
+            // make sure it doesn't try to access the elements anymore
+            RTListBase<T>::init();
+            if (nodes) delete[] nodes;
+            if (data)  delete[] data;
+        }
+
+        inline bool poolIsEmpty() const {
+            return freelist.isEmpty();
+        }
+
+        /**
+         * Returns the current size of the pool, that is the amount of
+         * pre-allocated elements from the operating system. It equals the
+         * amount of elements given to the constructor unless resizePool()
+         * is called.
+         *
+         * @see resizePool()
+         */
+        uint poolSize() const {
+            return poolsize;
+        }
+
+        /**
+         * Alters the amount of elements to be pre-allocated from the
+         * operating system for this pool object.
+         *
+         * @e CAUTION: you MUST free all elements in use before calling this
+         * method ( e.g. by calling clear() )! Also make sure that no
+         * references of elements before this call will still be used after this
+         * call, since all elements will be reallocated and their old memory
+         * addresses become invalid!
+         *
+         * @see poolSize()
+         */
+        void resizePool(int Elements) {
+            if (freelist.count() != poolsize) {
+                #if CONFIG_DEVMODE
+                throw std::runtime_error(__err_msg_resize_while_in_use);
+                #else
+                std::cerr << __err_msg_resize_while_in_use << std::endl << std::flush;
+                // if we're here something's terribly wrong, but we try to do the best
+                RTList<T>::clear();
+                #endif
+            }
+            if (nodes) delete[] nodes;
+            if (data)  delete[] data;
+            freelist.init();
+            RTListBase<T>::init();
+            _init(Elements);
+        }
+
+        /**
+         * Sets the amount of bits on the left hand side of pool_element_id_t
+         * numbers to be reserved for 3rd party usage.
+         *
+         * @param bits - amount of bits to reserve on every ID for other purposes
+         * @see pool_element_id_t
+         */
+        void setPoolElementIDsReservedBits(uint bits) {
+            reservedbits = bits;
+            updateReincarnationBits();
+        }
+
+        /**
+         * Returns an abstract, unique numeric ID for the given object of
+         * this pool, it returns 0 in case the passed object is not a member
+         * of this Pool. See the pointer based implementation in Pool.h for
+         * details.
+         *
+         * @param obj - raw pointer to a data member of this Pool
+         * @returns unique numeric ID (!= 0) of @a obj or 0 if pointer was invalid
+         */
+        pool_element_id_t getID(const T* obj) const {
+            if (!poolsize) return 0;
+            int index = int( obj - &data[0] );
+            if (index < 0 || index >= poolsize) return 0;
+            return ((nodes[index].reincarnation << poolsizebits) | index) + 1;
+        }
+
+        /**
+         * Overridden convenience method, behaves like the method above.
+         */
+        pool_element_id_t getID(const Iterator& it) const {
+            return getID(&*it);
+        }
+
+        /**
+         * Returns an Iterator object of the Pool data member reflected by the
+         * given abstract, unique numeric ID, it returns an invalid Iterator in
+         * case the ID is invalid or if the Pool's data element reflected by
+         * given ID was at least once released/freed back to the Pool in the
+         * meantime.
+         *
+         * @param id - unique ID (!= 0) of a Pool's data member
+         * @returns Iterator object pointing to Pool's data element, invalid
+         *          Iterator in case ID was invalid or data element was freed
+         */
+        Iterator fromID(pool_element_id_t id) const {
+            //TODO: -1 check here is a relict from older versions of Pool.h, once it is certain that no existing code base is still using -1 for "invalid" Pool elements then this -1 check can be removed
+            if (id == 0 || id == -1) return Iterator(); // invalid iterator
+            id--;
+            const uint bits = poolsizebits;
+            uint index = id & ((1 << bits) - 1);
+            if (index >= poolsize) return Iterator(); // invalid iterator
+            uint reincarnation = id >> bits;
+            if (reincarnation != nodes[index].reincarnation) return Iterator(); // invalid iterator
+            return Iterator(const_cast<Pool<T>*>(this), index);
+        }
+
+        /**
+         * Returns an Iterator object for the object pointed by @a obj. This
+         * method will check whether the supplied object is actually part of
+         * this pool, and if it is not part of this pool an invalid Iterator is
+         * returned instead.
+         *
+         * @param obj - raw pointer to an object managed by this pool
+         * @returns Iterator object pointing to the supplied object, invalid
+         *          Iterator in case object is not part of this pool
+         */
+        Iterator fromPtr(const T* obj) const {
+            if (!poolsize) return Iterator(); // invalid iterator
+            int index = int( obj - &data[0] );
+            if (index < 0 || index >= poolsize) return Iterator(); // invalid iterator
+            return Iterator(const_cast<Pool<T>*>(this), index);
+        }
+
+    protected:
+        // caution: assumes pool (that is freelist) is not empty!
+        inline Iterator alloc() {
+            Iterator element = freelist.last();
+            element.detach();
+            return element;
+        }
+
+        inline void freeToPool(Iterator itElement) {
+            nodes[itElement.index()].bumpReincarnation(reincarnationbits);
+            freelist.append(itElement);
+        }
+
+        inline void freeToPool(Iterator itFirst, Iterator itLast) {
+            const pool_link_t last = itLast.index();
+            for (pool_link_t i = itFirst.index(); true; i = nodes[i].next) {
+                nodes[i].bumpReincarnation(reincarnationbits);
+                if (i == last) break;
+            }
+            freelist.append(itFirst, itLast);
+        }
+
+        friend class RTList<T>;
+
+    private:
+        void _init(int Elements) {
+            data  = new T[Elements];
+            nodes = new Node[Elements];
+            for (int i = 0; i < Elements; i++)
+                freelist.append(Iterator(this, i));
+            poolsize = Elements;
+            poolsizebits = bitsForSize(poolsize + 1); // +1 here just because IDs are always incremented by one (to avoid them ever being zero)
+            updateReincarnationBits();
+        }
+
+        inline void updateReincarnationBits() {
+            reincarnationbits = sizeof(pool_element_id_t) * 8 - poolsizebits - reservedbits;
+        }
+
+        inline static int bitsForSize(int size) {
+            if (!size) return 0;
+            size--;
+            int bits = 0;
+            for (; size > 1; bits += 2, size >>= 2);
+            return bits + size;
+        }
+};
+
+#endif // __LS_INDEXEDPOOL_H__
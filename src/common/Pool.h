@@ -28,6 +28,11 @@
 # include <config.h>
 #endif
 
+// link elements by 32 bit indices instead of pointers (see IndexedPool.h)
+#ifndef CONFIG_INDEXED_POOL
+# define CONFIG_INDEXED_POOL 0
+#endif
+
 // we just use exceptions for debugging, better not in the final realtime thread !
 #ifndef CONFIG_RT_EXCEPTIONS
 # define CONFIG_RT_EXCEPTIONS 0
@@ -66,6 +71,10 @@ typedef uint32_t pool_element_id_t;
 template<typename T> class Pool;
 template<typename T> class RTList;
 
+#if CONFIG_INDEXED_POOL
+# include "IndexedPool.h"
+#else
+
 template<typename T>
 class RTListBase {
     protected:
@@ -539,7 +548,7 @@ class RTListBase {
             src->prev  = prev;
             src->next  = dst;
             #if CONFIG_DEVMODE
-            src->list = this;
+            src->list = dst->list;
             #endif // CONFIG_DEVMODE
         }
 
@@ -552,7 +561,7 @@ class RTListBase {
             src->prev  = dst;
             src->next  = next;
             #if CONFIG_DEVMODE
-            src->list = this;
+            src->list = dst->list;
             #endif // CONFIG_DEVMODE
         }
 
@@ -626,7 +635,7 @@ class RTList : public RTListBase<T> {
         inline Iterator allocPrepend() {
             if (pPool->poolIsEmpty()) return RTListBase<T>::end();
             Iterator element = pPool->alloc();
-            prepend(element);
+            this->prepend(element);
             #if CONFIG_DEVMODE
             element.list = this;
             #endif // CONFIG_DEVMODE
@@ -894,4 +903,6 @@ class Pool : public RTList<T> {
         }
 };
 
+#endif // CONFIG_INDEXED_POOL
+
 #endif // __LS_POOL_H__
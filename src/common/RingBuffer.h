@@ -26,6 +26,10 @@
 
 #define DEFAULT_WRAP_ELEMENTS 0
 
+// assumed size of a CPU cache line, used to keep the reader's and writer's
+// data of a RingBuffer on separate cache lines
+#define RINGBUFFER_CACHE_LINE_SIZE 64
+
 #include <string.h>
 
 #include "lsatomic.h"
@@ -44,6 +48,12 @@ using LinuxSampler::memory_order_release;
  * RingBuffer is created and no system level mechanisms are used for
  * ensuring thread safety of this class.
  *
+ * The read and write position are kept on separate cache lines, each
+ * together with the respective thread's private copy of the other
+ * thread's position. So read() and write() usually only touch their own
+ * cache line and only load the other thread's position if the cached one
+ * does not provide enough elements / space anymore.
+ *
  * <b>Important:</b> There are two distinct behaviors of this RingBuffer
  * which has to be given as template argument @c T_DEEP_COPY, which is a
  * boolean flag:
@@ -68,10 +78,45 @@ class RingBuffer
 {
 public:
     RingBuffer (int sz, int wrap_elements = DEFAULT_WRAP_ELEMENTS) :
-        write_ptr(0), read_ptr(0)
+        write_ptr(0), cached_read_ptr(0), pending_write_ptr(0),
+        read_ptr(0), cached_write_ptr(0)
     {
         _allocBuffer(sz, wrap_elements);
     }
+
+    /**
+     * Creates a ring buffer which uses the given, already allocated memory
+     * instead of allocating its own buffer. The memory is not freed by the
+     * ring buffer, it is the caller's responsibility to keep it alive as
+     * long as the ring buffer exists and to free it afterwards.
+     *
+     * @param sz - size (amount of elements)
+     * @param wrap_elements - amount of wrap elements beyond buffer end
+     * @param pMemory - memory to be used, must be at least
+     *                  requiredElements(sz, wrap_elements) elements large
+     */
+    RingBuffer (int sz, int wrap_elements, T* pMemory) :
+        write_ptr(0), cached_read_ptr(0), pending_write_ptr(0),
+        read_ptr(0), cached_write_ptr(0)
+    {
+        _calcSize(sz, wrap_elements);
+        buf = pMemory;
+        ownsBuffer = false;
+    }
+
+    /**
+     * Returns the amount of elements a ring buffer with the given size
+     * and amount of wrap elements actually occupies, which is the memory
+     * size that has to be passed to the constructor above.
+     */
+    static int requiredElements(int sz, int wrap_elements) {
+        sz += wrap_elements;
+        int power_of_two;
+        for (power_of_two = 1;
+             1<<power_of_two < sz;
+             power_of_two++);
+        return (1<<power_of_two) + wrap_elements;
+    }
     
     /**
      * Resize this ring buffer to the given size. This operation
@@ -89,13 +134,31 @@ public:
         if (wrap_elements == -1)
             wrap_elements = this->wrap_elements;
         
-        delete [] buf;
+        if (ownsBuffer) delete [] buf;
         
         _allocBuffer(sz, wrap_elements);
     }
 
+    /**
+     * Lets this ring buffer use the given, already allocated memory from
+     * now on (see the constructor with memory argument above), and empties
+     * it. Like resize() this is not thread safe.
+     *
+     * @param sz - new size (amount of elements)
+     * @param wrap_elements - new amount of wrap elements beyond buffer end
+     * @param pMemory - memory to be used, must be at least
+     *                  requiredElements(sz, wrap_elements) elements large
+     */
+    void attach(int sz, int wrap_elements, T* pMemory) {
+        if (ownsBuffer) delete [] buf;
+        _calcSize(sz, wrap_elements);
+        buf = pMemory;
+        ownsBuffer = false;
+        init();
+    }
+
     virtual ~RingBuffer() {
-            delete [] buf;
+            if (ownsBuffer) delete [] buf;
     }
 
     /**
@@ -121,6 +184,15 @@ public:
 
     __inline int  read (T *dest, int cnt);
     __inline int  write (T *src, int cnt);
+    __inline int  write_deferred (T *src, int cnt);
+
+    /**
+     * Makes all elements written with write_deferred() so far visible to
+     * the reading thread at once.
+     */
+    inline void publish_write() {
+        _publish_write_ptr(write_ptr.load(memory_order_relaxed), pending_write_ptr);
+    }
 
     inline int push(T* src) { return write(src,1); }
     inline int pop(T* dst)  { return read(dst,1);  }
@@ -144,14 +216,17 @@ public:
 
     __inline T *get_write_ptr();
     __inline void increment_read_ptr(int cnt) {
-               read_ptr.store((read_ptr.load(memory_order_relaxed) + cnt) & size_mask, memory_order_release);
+               int r = read_ptr.load(memory_order_relaxed);
+               _publish_read_ptr(r, (r + cnt) & size_mask);
              }
+    /// Must only be used to advance the read position, never to move it back.
     __inline void set_read_ptr(int val) {
-               read_ptr.store(val, memory_order_release);
+               _publish_read_ptr(read_ptr.load(memory_order_relaxed), val);
              }
 
     __inline void increment_write_ptr(int cnt) {
-               write_ptr.store((write_ptr.load(memory_order_relaxed) + cnt) & size_mask, memory_order_release);
+               int w = write_ptr.load(memory_order_relaxed);
+               _publish_write_ptr(w, (w + cnt) & size_mask);
              }
 
     /* this function increments the write_ptr by cnt, if the buffer wraps then
@@ -166,14 +241,14 @@ public:
        and the write ptr incremented accordingly.
     */
     __inline void increment_write_ptr_with_wrap(int cnt) {
-               int w = write_ptr.load(memory_order_relaxed);
-               w += cnt;
+               const int old_w = write_ptr.load(memory_order_relaxed);
+               int w = old_w + cnt;
                if(w >= size) {
                  w -= size;
                  copy(&buf[0], &buf[size], w);
 //printf("DEBUG !!!! increment_write_ptr_with_wrap: buffer wrapped, elements wrapped = %d (wrap_elements %d)\n",w,wrap_elements);
                }
-               write_ptr.store(w, memory_order_release);
+               _publish_write_ptr(old_w, w);
              }
 
     /* this function returns the available write space in the buffer
@@ -263,35 +338,20 @@ public:
     __inline void init() {
                    write_ptr.store(0, memory_order_relaxed);
                    read_ptr.store(0, memory_order_relaxed);
+                   cached_read_ptr   = 0;
+                   cached_write_ptr  = 0;
+                   pending_write_ptr = 0;
                  //  wrap=0;
             }
 
     int write_space () {
-            int w, r;
-
-            w = write_ptr.load(memory_order_relaxed);
-            r = read_ptr.load(memory_order_acquire);
-
-            if (w > r) {
-                    return ((r - w + size) & size_mask) - 1;
-            } else if (w < r) {
-                    return (r - w) - 1;
-            } else {
-                    return size - 1;
-            }
+            return _write_space(write_ptr.load(memory_order_relaxed),
+                                read_ptr.load(memory_order_acquire));
     }
 
     int read_space () {
-            int w, r;
-
-            w = write_ptr.load(memory_order_acquire);
-            r = read_ptr.load(memory_order_relaxed);
-
-            if (w >= r) {
-                    return w - r;
-            } else {
-                    return (w - r + size) & size_mask;
-            }
+            return _read_space(write_ptr.load(memory_order_acquire),
+                               read_ptr.load(memory_order_relaxed));
     }
 
     int size;
@@ -418,7 +478,7 @@ public:
              * @see RingBuffer::increment_read_ptr()
              */
             void free() {
-                pBuf->read_ptr.store(read_ptr, memory_order_release);
+                pBuf->_publish_read_ptr(pBuf->read_ptr.load(memory_order_relaxed), read_ptr);
             }
 
         protected:
@@ -439,9 +499,60 @@ public:
 
   protected:
     T *buf;
+    bool ownsBuffer; ///< false if @c buf was supplied by the caller
+    int size_mask;
+
+    // the padding arrays keep the members only touched by the writing
+    // thread and those only touched by the reading thread on different
+    // cache lines than each other and than the rarely changing members
+    // above, to avoid both threads invalidating each other's cache line
+    // on every access (false sharing)
+    char _pad0[RINGBUFFER_CACHE_LINE_SIZE];
+
+    // writing thread
     atomic<int> write_ptr;
+    int cached_read_ptr;   ///< Writer's private copy of @c read_ptr, may be outdated.
+    int pending_write_ptr; ///< Write position after all write_deferred() calls, not yet published.
+
+    char _pad1[RINGBUFFER_CACHE_LINE_SIZE];
+
+    // reading thread
     atomic<int> read_ptr;
-    int size_mask;
+    int cached_write_ptr;  ///< Reader's private copy of @c write_ptr, may be outdated.
+
+    char _pad2[RINGBUFFER_CACHE_LINE_SIZE];
+
+    inline int _write_space(int w, int r) const {
+        return (r - w - 1) & size_mask;
+    }
+
+    inline int _read_space(int w, int r) const {
+        return (w - r) & size_mask;
+    }
+
+    /**
+     * Publishes the new write position @a new_w to the reader. If the new
+     * position passed the cached read position (i.e. because the writer
+     * used write_space() instead of the cache to calculate the amount of
+     * elements to write), the cache is reset to "buffer full" to keep it
+     * a conservative estimate.
+     */
+    inline void _publish_write_ptr(int old_w, int new_w) {
+        if (((new_w - old_w) & size_mask) > _write_space(old_w, cached_read_ptr))
+            cached_read_ptr = (new_w + 1) & size_mask;
+        pending_write_ptr = new_w;
+        write_ptr.store(new_w, memory_order_release);
+    }
+
+    /**
+     * Publishes the new read position @a new_r to the writer, see
+     * _publish_write_ptr().
+     */
+    inline void _publish_read_ptr(int old_r, int new_r) {
+        if (((new_r - old_r) & size_mask) > _read_space(cached_write_ptr, old_r))
+            cached_write_ptr = new_r;
+        read_ptr.store(new_r, memory_order_release);
+    }
 
     /**
      * Copies \a n amount of elements from the buffer given by
@@ -449,22 +560,20 @@ public:
      */
     inline static void copy(T* pDst, T* pSrc, int n);
     
-    void _allocBuffer(int sz, int wrap_elements) {
+    void _calcSize(int sz, int wrap_elements) {
         this->wrap_elements = wrap_elements;
             
         // the write-with-wrap functions need wrap_elements extra
         // space in the buffer to be able to copy the wrap space
-        sz += wrap_elements;
-
-        int power_of_two;
-        for (power_of_two = 1;
-             1<<power_of_two < sz;
-             power_of_two++);
-
-        size = 1<<power_of_two;
+        size = requiredElements(sz, wrap_elements) - wrap_elements;
         size_mask = size;
         size_mask -= 1;
+    }
+
+    void _allocBuffer(int sz, int wrap_elements) {
+        _calcSize(sz, wrap_elements);
         buf = new T[size + wrap_elements];   
+        ownsBuffer = true;
     }
 
     friend class _NonVolatileReader<T,T_DEEP_COPY>;
@@ -493,7 +602,13 @@ int RingBuffer<T,T_DEEP_COPY>::read(T* dest, int cnt)
 
         priv_read_ptr = read_ptr.load(memory_order_relaxed);
 
-        if ((free_cnt = read_space ()) == 0) {
+        // only load the writer's position if the cached one is not enough
+        free_cnt = _read_space(cached_write_ptr, priv_read_ptr);
+        if (free_cnt < cnt) {
+                cached_write_ptr = write_ptr.load(memory_order_acquire);
+                free_cnt = _read_space(cached_write_ptr, priv_read_ptr);
+        }
+        if (free_cnt == 0) {
                 return 0;
         }
 
@@ -517,12 +632,27 @@ int RingBuffer<T,T_DEEP_COPY>::read(T* dest, int cnt)
                 priv_read_ptr = n2;
         }
 
+        // the cache provided to_read elements, so it stays valid
         read_ptr.store(priv_read_ptr, memory_order_release);
         return to_read;
 }
 
 template<class T, bool T_DEEP_COPY>
 int RingBuffer<T,T_DEEP_COPY>::write(T* src, int cnt)
+{
+        const int written = write_deferred(src, cnt);
+        if (written) publish_write();
+        return written;
+}
+
+/**
+ * Same as write(), but the written elements are not visible to the reading
+ * thread until publish_write() is called. This allows to write several
+ * chunks of data and to hand them over to the reader at once. Other
+ * writing methods must not be used before publish_write() was called.
+ */
+template<class T, bool T_DEEP_COPY>
+int RingBuffer<T,T_DEEP_COPY>::write_deferred(T* src, int cnt)
 {
         int free_cnt;
         int cnt2;
@@ -530,9 +660,15 @@ int RingBuffer<T,T_DEEP_COPY>::write(T* src, int cnt)
         int n1, n2;
         int priv_write_ptr;
 
-        priv_write_ptr = write_ptr.load(memory_order_relaxed);
+        priv_write_ptr = pending_write_ptr;
 
-        if ((free_cnt = write_space ()) == 0) {
+        // only load the reader's position if the cached one is not enough
+        free_cnt = _write_space(priv_write_ptr, cached_read_ptr);
+        if (free_cnt < cnt) {
+                cached_read_ptr = read_ptr.load(memory_order_acquire);
+                free_cnt = _write_space(priv_write_ptr, cached_read_ptr);
+        }
+        if (free_cnt == 0) {
                 return 0;
         }
 
@@ -555,7 +691,7 @@ int RingBuffer<T,T_DEEP_COPY>::write(T* src, int cnt)
                 copy(buf, src+n1, n2);
                 priv_write_ptr = n2;
         }
-        write_ptr.store(priv_write_ptr, memory_order_release);
+        pending_write_ptr = priv_write_ptr;
         return to_write;
 }
 
@@ -23,6 +23,10 @@
 
 #include "Thread.h"
 
+#include <ctype.h>
+#include <set>
+#include <sstream>
+
 #if HAVE_CONFIG_H
 # include <config.h>
 #endif
@@ -40,15 +44,43 @@ namespace LinuxSampler {
 DWORD WINAPI __win32thread_launcher(LPVOID lpParameter);
 #else
 // Callback functions for the POSIX thread API
-static void* __pthread_launcher(void* thread);
+void* __pthread_launcher(void* thread); // not static, since it's a friend of class Thread
 static void  __pthread_destructor(void* thread);
 #endif
 
+// CPU affinity assigned to each thread role (empty means all CPUs) and all
+// threads which have a role assigned, protected by the returned mutex
+static Mutex& __cpu_affinity_mutex() {
+    static Mutex mutex;
+    return mutex;
+}
+static std::vector<int>* __cpu_affinity() {
+    static std::vector<int> affinity[Thread::ROLE_COUNT];
+    return affinity;
+}
+static std::set<Thread*>& __role_threads() {
+    static std::set<Thread*> threads;
+    return threads;
+}
+
+#if defined(__linux__)
+// CPU affinity of the process when it was started (e.g. restricted by
+// taskset), which threads without an assigned CPU affinity are kept on
+static cpu_set_t __startup_cpu_set;
+static const bool __startup_cpu_set_valid =
+    sched_getaffinity(0, sizeof(__startup_cpu_set), &__startup_cpu_set) == 0;
+#endif
+
+static const char* __role_names[Thread::ROLE_COUNT] = {
+    "OTHER", "AUDIO", "MIDI", "DISK", "LOADER", "LSCP"
+};
+
 Thread::Thread(bool LockMemory, bool RealTime, int PriorityMax, int PriorityDelta) {
     this->bLockedMemory     = LockMemory;
     this->isRealTime        = RealTime;
     this->PriorityDelta     = PriorityDelta;
     this->PriorityMax       = PriorityMax;
+    this->role              = ROLE_OTHER;
 #if defined(WIN32)
 #if defined(WIN32_SIGNALSTARTTHREAD_WORKAROUND)
     win32isRunning = false;
@@ -60,6 +92,10 @@ Thread::Thread(bool LockMemory, bool RealTime, int PriorityMax, int PriorityDelt
 }
 
 Thread::~Thread() {
+    if (role != ROLE_OTHER) {
+        LockGuard lock(__cpu_affinity_mutex());
+        __role_threads().erase(this);
+    }
     StopThread();
 #if defined(WIN32)
 #else
@@ -315,6 +351,151 @@ int Thread::SetSchedulingPriority() {
 #endif	
 }
 
+/**
+ * Assigns this thread to the given role, so it will be pinned to the CPUs
+ * assigned to that role with SetCpuAffinity(). Should be called by the
+ * descendant's constructor.
+ */
+void Thread::SetRole(role_t Role) {
+    LockGuard lock(__cpu_affinity_mutex());
+    if (Role == ROLE_OTHER) __role_threads().erase(this);
+    else __role_threads().insert(this);
+    role = Role;
+}
+
+/**
+ * Pins this thread to the CPUs assigned to its role. Called by the thread
+ * itself when it starts and by SetCpuAffinity() for running threads.
+ *
+ * If no CPUs are assigned to the role, the thread is put back on the CPUs
+ * the process was started with. A thread just started is only changed if
+ * it inherited a different affinity from the thread which spawned it
+ * (i.e. from a thread of another role), so an affinity assigned to this
+ * thread from outside meanwhile is left alone.
+ *
+ * @param bCurrentThread - true if called by this thread itself
+ */
+int Thread::ApplyCpuAffinity(bool bCurrentThread) {
+    if (role == ROLE_OTHER) return 0;
+#if defined(__linux__)
+    // when called from the thread itself right after it was spawned,
+    // __thread_id might not be assigned yet
+    pthread_t tid = (bCurrentThread) ? pthread_self() : __thread_id;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    const std::vector<int>& cpus = __cpu_affinity()[role];
+    if (cpus.empty()) { // no affinity assigned, restore the startup one
+        if (!__startup_cpu_set_valid) return 0;
+        if (bCurrentThread) {
+            cpu_set_t current;
+            if (pthread_getaffinity_np(tid, sizeof(current), &current) == 0 &&
+                CPU_EQUAL(&current, &__startup_cpu_set)) return 0;
+        }
+        set = __startup_cpu_set;
+    } else {
+        for (size_t i = 0; i < cpus.size(); i++) CPU_SET(cpus[i], &set);
+    }
+    if (pthread_setaffinity_np(tid, sizeof(set), &set) != 0) {
+        std::cerr << "Thread: WARNING, can't assign CPU affinity to "
+                  << __role_names[role] << " thread!"
+                  << std::endl << std::flush;
+        return -1;
+    }
+#endif
+    return 0;
+}
+
+/**
+ * Pins all threads of the given role to the given CPUs. This applies to
+ * already running threads of that role immediately and to all threads of
+ * that role started later on.
+ *
+ * @param Role - thread role, must not be ROLE_OTHER
+ * @param Cpus - CPU numbers (starting with 0), empty for all CPUs
+ * @returns false if the role or a CPU number is invalid or CPU affinity is
+ *          not supported on this system
+ */
+bool Thread::SetCpuAffinity(role_t Role, const std::vector<int>& Cpus) {
+#if defined(__linux__)
+    if (Role <= ROLE_OTHER || Role >= ROLE_COUNT) return false;
+    for (size_t i = 0; i < Cpus.size(); i++)
+        if (Cpus[i] < 0 || Cpus[i] >= CPU_SETSIZE) return false;
+    LockGuard lock(__cpu_affinity_mutex());
+    __cpu_affinity()[Role] = Cpus;
+    std::set<Thread*>::iterator it = __role_threads().begin();
+    for (; it != __role_threads().end(); ++it)
+        if ((*it)->role == Role && (*it)->IsRunning()) (*it)->ApplyCpuAffinity(false);
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Returns the CPUs assigned to the given role with SetCpuAffinity(), an
+ * empty list means all CPUs.
+ */
+std::vector<int> Thread::GetCpuAffinity(role_t Role) {
+    if (Role <= ROLE_OTHER || Role >= ROLE_COUNT) return std::vector<int>();
+    LockGuard lock(__cpu_affinity_mutex());
+    return __cpu_affinity()[Role];
+}
+
+/**
+ * Resolves a role name like "AUDIO" or "disk" (case insensitive).
+ *
+ * @returns false if there is no role with that name
+ */
+bool Thread::RoleByName(std::string Name, role_t& Role) {
+    for (size_t i = 0; i < Name.size(); i++) Name[i] = toupper(Name[i]);
+    for (int i = ROLE_OTHER + 1; i < ROLE_COUNT; i++) {
+        if (Name == __role_names[i]) {
+            Role = (role_t) i;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Parses a CPU list like "2,4-7" (the format used by taskset and by the
+ * isolcpus kernel parameter). An empty string or "all" means all CPUs.
+ *
+ * @returns false if the list could not be parsed
+ */
+bool Thread::ParseCpuList(std::string List, std::vector<int>& Cpus) {
+    Cpus.clear();
+    if (List.empty() || List == "all" || List == "ALL") return true;
+    std::stringstream ss(List);
+    std::string range;
+    while (std::getline(ss, range, ',')) {
+        int first, last;
+        char dash;
+        std::stringstream rs(range);
+        if (!(rs >> first) || first < 0) return false;
+        if (rs >> dash) {
+            if (dash != '-' || !(rs >> last) || last < first || last - first > 65535) return false;
+        } else {
+            last = first;
+        }
+        for (int i = first; i <= last; i++) Cpus.push_back(i);
+    }
+    return !Cpus.empty();
+}
+
+/**
+ * Inverse of ParseCpuList(), returns "all" for an empty list.
+ */
+std::string Thread::CpuListToString(const std::vector<int>& Cpus) {
+    if (Cpus.empty()) return "all";
+    std::stringstream ss;
+    for (size_t i = 0; i < Cpus.size(); i++) {
+        if (i) ss << ",";
+        ss << Cpus[i];
+    }
+    return ss.str();
+}
+
 /**
  * Locks the memory so it will not be swapped out by the operating system.
  */
@@ -389,7 +570,7 @@ DWORD WINAPI __win32thread_launcher(LPVOID lpParameter) {
 }
 #else
 /// Callback function for the POSIX thread API
-static void* __pthread_launcher(void* thread) {
+void* __pthread_launcher(void* thread) {
 #if !CONFIG_PTHREAD_TESTCANCEL
     pthread_setcanceltype(PTHREAD_CANCEL_ASYNCHRONOUS, NULL); // let the thread be killable under any circumstances
 #endif
@@ -397,6 +578,10 @@ static void* __pthread_launcher(void* thread) {
     Thread* t;
     t = (Thread*) thread;
     t->SetSchedulingPriority();
+    {
+        LockGuard lock(__cpu_affinity_mutex());
+        t->ApplyCpuAffinity(true);
+    }
     t->LockMemory();
     t->EnableDestructor();
     t->Main();
@@ -42,6 +42,8 @@
 #include <pthread.h>
 #endif
 #include <errno.h>
+#include <string>
+#include <vector>
 
 #include "Condition.h"
 
@@ -50,6 +52,20 @@ namespace LinuxSampler {
 /// Abstract base class for classes that need to run in an own thread.
 class Thread {
     public:
+        /**
+         * Roles of threads. All threads of the same role share the same
+         * CPU affinity, which can be assigned with SetCpuAffinity().
+         */
+        enum role_t {
+            ROLE_OTHER,  ///< Threads not belonging to one of the roles below (CPU affinity cannot be assigned).
+            ROLE_AUDIO,  ///< Audio output driver threads, which render the audio.
+            ROLE_MIDI,   ///< MIDI input driver threads.
+            ROLE_DISK,   ///< Disk streaming threads.
+            ROLE_LOADER, ///< Background instrument loading and instruments DB jobs.
+            ROLE_LSCP,   ///< LSCP network server thread.
+            ROLE_COUNT   ///< Not a role, just the amount of roles.
+        };
+
         Thread(bool LockMemory, bool RealTime, int PriorityMax, int PriorityDelta);
         virtual ~Thread();
         virtual int  StartThread();
@@ -66,6 +82,12 @@ class Thread {
         virtual int  Destructor();            //FIXME: should be private
         virtual int  Main() = 0; ///< This method needs to be implemented by the descendant and is the entry point for the new thread. FIXME: should be protected
 
+        static bool SetCpuAffinity(role_t Role, const std::vector<int>& Cpus);
+        static std::vector<int> GetCpuAffinity(role_t Role);
+        static bool RoleByName(std::string Name, role_t& Role);
+        static bool ParseCpuList(std::string List, std::vector<int>& Cpus);
+        static std::string CpuListToString(const std::vector<int>& Cpus);
+
         /**
          * Allocates an aligned block of memory. Allocated memory blocks
          * need to be freed using freeAlignedMem().
@@ -124,7 +146,16 @@ class Thread {
             #endif
         }
 
+    protected:
+        void SetRole(role_t Role);
+
     private:
+        int ApplyCpuAffinity(bool bCurrentThread);
+
+    #if !defined(WIN32)
+        friend void* __pthread_launcher(void* thread);
+    #endif
+
     #if defined(WIN32)
         HANDLE hThread;
         DWORD lpThreadId;
@@ -141,6 +172,7 @@ class Thread {
         int             PriorityDelta;
         bool            isRealTime;
         bool            bLockedMemory;
+        role_t          role;
 };
 
 } // namespace LinuxSampler
@@ -0,0 +1,207 @@
+/***************************************************************************
+ *                                                                         *
+ *   LinuxSampler - modular, streaming capable sampler                     *
+ *                                                                         *
+ *   Copyright (C) 2026 The LinuxSampler Developers                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston,                 *
+ *   MA  02111-1307  USA                                                   *
+ ***************************************************************************/
+
+#include "WorkerPool.h"
+
+#include "Exception.h"
+
+#if defined(WIN32)
+# include <windows.h>
+#else
+# include <unistd.h>
+#endif
+
+namespace LinuxSampler {
+
+    // Amount of CPUs background jobs may run on.
+    static int loaderCpuCount() {
+        std::vector<int> cpus = Thread::GetCpuAffinity(Thread::ROLE_LOADER);
+        if (!cpus.empty()) return (int) cpus.size();
+        #if defined(WIN32)
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return (int) info.dwNumberOfProcessors;
+        #else
+        long n = sysconf(_SC_NPROCESSORS_ONLN);
+        return (n > 0) ? (int) n : 1;
+        #endif
+    }
+
+    WorkerPool::Worker::Worker(WorkerPool* pPool, int Index)
+        : Thread(true, false, 0, -4), pPool(pPool), index(Index)
+    {
+        SetRole(ROLE_LOADER);
+    }
+
+    // Entry point for each worker thread.
+    int WorkerPool::Worker::Main() {
+        while (true) {
+
+            #if CONFIG_PTHREAD_TESTCANCEL
+            TestCancel();
+            #endif
+
+            job_t job;
+            if (pPool->TakeJob(index, job)) {
+                pPool->Run(job);
+                continue;
+            }
+
+            // nothing left to do, sleep until new jobs arrive
+            {
+                LockGuard lock(pPool->poolMutex);
+                if (pPool->pendingJobs > 0) continue; // queued meanwhile
+                pPool->conditionJobsLeft.Set(false);
+            }
+            pPool->conditionJobsLeft.WaitAndUnlockIf(false);
+        }
+        return 0;
+    }
+
+    WorkerPool::WorkerPool(int Workers)
+        : requestedWorkers(Workers), nextWorker(0), nextJobId(0), pendingJobs(0)
+    {
+    }
+
+    WorkerPool::~WorkerPool() {
+        for (size_t i = 0; i < workers.size(); i++)
+            workers[i]->StopThread();
+        for (size_t i = 0; i < workers.size(); i++) {
+            for (int p = 0; p < PRIORITY_COUNT; p++) {
+                std::deque<job_t>& queue = workers[i]->queue[p];
+                for (size_t j = 0; j < queue.size(); j++)
+                    delete queue[j].pRunnable;
+            }
+            delete workers[i];
+        }
+    }
+
+    int WorkerPool::Execute(Runnable* pJob, priority_t Priority) {
+        job_t job;
+        job.pRunnable = pJob;
+        Worker* pWorker;
+        bool start = false;
+        {
+            LockGuard lock(poolMutex);
+            if (workers.empty()) {
+                // created on first use, after the CPU affinities were assigned
+                int n = (requestedWorkers < 1) ? loaderCpuCount() : requestedWorkers;
+                for (int i = 0; i < n; i++)
+                    workers.push_back(new Worker(this, i));
+                start = true;
+            }
+            if (++nextJobId < 0) nextJobId = 1;
+            job.id = nextJobId;
+            pWorker = workers[nextWorker];
+            nextWorker = (nextWorker + 1) % workers.size();
+        }
+        {
+            LockGuard lock(pWorker->mutex);
+            pWorker->queue[Priority].push_back(job);
+            LockGuard lock2(poolMutex);
+            pendingJobs++;
+            conditionJobsLeft.Set(true); // wake up idle workers
+        }
+        if (start) {
+            for (size_t i = 0; i < workers.size(); i++)
+                workers[i]->StartThread();
+        }
+        return job.id;
+    }
+
+    bool WorkerPool::Cancel(int JobId) {
+        {
+            LockGuard lock(poolMutex);
+            if (workers.empty()) return false;
+        }
+        job_t job;
+        job.pRunnable = NULL;
+        for (size_t i = 0; i < workers.size() && !job.pRunnable; i++) {
+            LockGuard lock(workers[i]->mutex);
+            for (int p = 0; p < PRIORITY_COUNT && !job.pRunnable; p++) {
+                std::deque<job_t>& queue = workers[i]->queue[p];
+                for (std::deque<job_t>::iterator it = queue.begin(); it != queue.end(); ++it) {
+                    if (it->id != JobId) continue;
+                    job = *it;
+                    queue.erase(it);
+                    LockGuard lock2(poolMutex);
+                    pendingJobs--;
+                    break;
+                }
+            }
+        }
+        if (!job.pRunnable) return false;
+        delete job.pRunnable;
+        return true;
+    }
+
+    int WorkerPool::GetPendingJobCount() {
+        LockGuard lock(poolMutex);
+        return pendingJobs;
+    }
+
+    int WorkerPool::GetWorkerCount() {
+        LockGuard lock(poolMutex);
+        return (int) workers.size();
+    }
+
+    /**
+     * Takes the next job for the given worker: for each priority (highest
+     * first) the oldest job of the worker's own queue, or otherwise the
+     * newest job of another worker's queue.
+     */
+    bool WorkerPool::TakeJob(int Worker, job_t& Job) {
+        const int n = (int) workers.size();
+        for (int p = PRIORITY_COUNT - 1; p >= 0; p--) {
+            for (int i = 0; i < n; i++) {
+                WorkerPool::Worker* pVictim = workers[(Worker + i) % n];
+                LockGuard lock(pVictim->mutex);
+                std::deque<job_t>& queue = pVictim->queue[p];
+                if (queue.empty()) continue;
+                if (i == 0) { // own queue
+                    Job = queue.front();
+                    queue.pop_front();
+                } else { // steal
+                    Job = queue.back();
+                    queue.pop_back();
+                }
+                LockGuard lock2(poolMutex);
+                pendingJobs--;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void WorkerPool::Run(job_t& Job) {
+        try {
+            Job.pRunnable->Run();
+        } catch (Exception e) {
+            e.PrintMessage();
+        } catch (...) {
+            std::cerr << "WorkerPool: an exception occured, could not finish the job";
+            std::cerr << std::endl << std::flush;
+        }
+        delete Job.pRunnable;
+    }
+
+} // namespace LinuxSampler
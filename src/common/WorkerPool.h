@@ -0,0 +1,137 @@
+/***************************************************************************
+ *                                                                         *
+ *   LinuxSampler - modular, streaming capable sampler                     *
+ *                                                                         *
+ *   Copyright (C) 2026 The LinuxSampler Developers                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston,                 *
+ *   MA  02111-1307  USA                                                   *
+ ***************************************************************************/
+
+#ifndef __LS_WORKER_POOL_H__
+#define __LS_WORKER_POOL_H__
+
+#include <deque>
+#include <vector>
+
+#include "Condition.h"
+#include "Mutex.h"
+#include "global_private.h"
+#include "Thread.h"
+
+namespace LinuxSampler {
+
+    /**
+     * Pool of background threads executing Runnable jobs, a multi threaded
+     * replacement for WorkerThread.
+     *
+     * Each worker has its own job queues (one per priority). New jobs are
+     * distributed over the workers' queues round robin, a worker takes the
+     * oldest job of its own queue and when that is empty it steals the
+     * newest job from another worker's queue, so a worker stuck with a long
+     * job does not hold up the jobs queued behind it. Jobs of a higher
+     * priority are always taken before jobs of a lower priority, no matter
+     * which queue they are in.
+     *
+     * The worker threads are created with the first job and run with
+     * ROLE_LOADER, at the same (non real time) priority as WorkerThread.
+     */
+    class WorkerPool {
+        public:
+            enum priority_t {
+                PRIORITY_LOW,    ///< Jobs that may wait until everything else is done.
+                PRIORITY_NORMAL, ///< Default priority.
+                PRIORITY_HIGH,   ///< Jobs some user is waiting for.
+                PRIORITY_COUNT   ///< Not a priority, just the amount of priorities.
+            };
+
+            /**
+             * @param Workers - amount of worker threads, -1 for one per CPU
+             *                  assigned to ROLE_LOADER (or one per CPU of
+             *                  the system if none were assigned)
+             */
+            WorkerPool(int Workers = -1);
+
+            /**
+             * Stops all workers. Jobs that were not started yet are
+             * deleted without being executed.
+             */
+            virtual ~WorkerPool();
+
+            /**
+             * Schedules the specified job for execution.
+             * Note that the specified Runnable object must be allocated
+             * using the new operator. The object is automatically deleted
+             * when the job is finished (or cancelled).
+             *
+             * @returns ID of the job, which can be passed to Cancel()
+             */
+            int Execute(Runnable* pJob, priority_t Priority = PRIORITY_NORMAL);
+
+            /**
+             * Removes the job with the given ID from the queues and deletes
+             * it, if it was not started yet. Jobs that are already running
+             * are not interrupted.
+             *
+             * @returns true if the job was cancelled, false if it is already
+             *          running or finished
+             */
+            bool Cancel(int JobId);
+
+            /**
+             * Returns the amount of jobs which were not started yet.
+             */
+            int GetPendingJobCount();
+
+            /**
+             * Returns the amount of worker threads, 0 before the first job.
+             */
+            int GetWorkerCount();
+
+        private:
+            struct job_t {
+                int       id;
+                Runnable* pRunnable;
+            };
+
+            class Worker : public Thread {
+                public:
+                    Worker(WorkerPool* pPool, int Index);
+                    virtual int Main() OVERRIDE;
+
+                    std::deque<job_t> queue[PRIORITY_COUNT]; // jobs assigned to this worker
+                    Mutex             mutex; // used to synchronize the queues
+                private:
+                    WorkerPool* pPool;
+                    int         index;
+            };
+
+            bool TakeJob(int Worker, job_t& Job);
+            void Run(job_t& Job);
+
+            std::vector<Worker*> workers; // created with the first job, not changed afterwards
+            int                  requestedWorkers;
+            Mutex                poolMutex; // protects the members below and the sleep / wake up handshake
+            int                  nextWorker; // worker the next job is queued at
+            int                  nextJobId;
+            int                  pendingJobs; // jobs queued but not taken by a worker yet
+            Condition            conditionJobsLeft; // synchronizer to block idle workers until a new job arrives
+
+        friend class Worker;
+    };
+
+} // namespace LinuxSampler
+
+#endif // __LS_WORKER_POOL_H__
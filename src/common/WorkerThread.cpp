@@ -24,7 +24,9 @@
 
 namespace LinuxSampler {
 
-    WorkerThread::WorkerThread() : Thread(true, false, 0, -4) { }
+    WorkerThread::WorkerThread() : Thread(true, false, 0, -4) {
+        SetRole(ROLE_LOADER);
+    }
 
     void WorkerThread::Execute(Runnable* pJob) {
         {
@@ -42,6 +42,9 @@
 #ifndef CONFIG_EG_BOTTOM
 # error "Configuration macro CONFIG_EG_BOTTOM not defined!"
 #endif // CONFIG_EG_BOTTOM
+#ifndef CONFIG_VOICE_CULL_THRESHOLD
+# error "Configuration macro CONFIG_VOICE_CULL_THRESHOLD not defined!"
+#endif // CONFIG_VOICE_CULL_THRESHOLD
 #ifndef CONFIG_EG_MIN_RELEASE_TIME
 # error "Configuration macro CONFIG_EG_MIN_RELEASE_TIME not defined!"
 #endif // CONFIG_EG_MIN_RELEASE_TIME
@@ -98,6 +101,10 @@ int GLOBAL_MAX_VOICES = CONFIG_DEFAULT_MAX_VOICES;
 // this is the sampler global setting for maximum disk streams
 int GLOBAL_MAX_STREAMS = CONFIG_DEFAULT_MAX_STREAMS;
 
+// amplitude below which voices are considered to be inaudible by all sampler
+// engine implementations (0 disables culling of inaudible voices)
+double GLOBAL_VOICE_CULL_THRESHOLD = CONFIG_VOICE_CULL_THRESHOLD;
+
 //TODO: (hopefully) just a temporary nasty hack for launching gigedit on the main thread on Mac (see comments in gigedit.cpp for details)
 #if defined(__APPLE__)
 bool g_mainThreadCallbackSupported = false;
@@ -129,6 +129,7 @@ class Runnable {
 extern double GLOBAL_VOLUME;
 extern int GLOBAL_MAX_VOICES;
 extern int GLOBAL_MAX_STREAMS;
+extern double GLOBAL_VOICE_CULL_THRESHOLD;
 
 //TODO: (hopefully) just a temporary nasty hack for launching gigedit on the main thread on Mac (see comments in gigedit.cpp for details)
 #if defined(__APPLE__)
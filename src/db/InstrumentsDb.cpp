@@ -740,7 +740,7 @@ namespace LinuxSampler {
 
         ScanJob job;
         int jobId = Jobs.AddJob(job);
-        InstrumentsDbThread.Execute(new AddInstrumentsJob(jobId, Mode, DbDir, FsDir, insDir));
+        InstrumentsDbWorkers.Execute(new AddInstrumentsJob(jobId, Mode, DbDir, FsDir, insDir));
 
         return jobId;
     }
@@ -754,7 +754,7 @@ namespace LinuxSampler {
 
         ScanJob job;
         int jobId = Jobs.AddJob(job);
-        InstrumentsDbThread.Execute(new AddInstrumentsFromFileJob(jobId, DbDir, FilePath, Index, false));
+        InstrumentsDbWorkers.Execute(new AddInstrumentsFromFileJob(jobId, DbDir, FilePath, Index, false));
 
         return jobId;
     } 
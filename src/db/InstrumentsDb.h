@@ -30,7 +30,7 @@
 # include <gig.h>
 #endif
 #include "../common/Mutex.h"
-#include "../common/WorkerThread.h"
+#include "../common/WorkerPool.h"
 #include "../EventListeners.h"
 #include "InstrumentsDbUtilities.h"
 
@@ -492,7 +492,7 @@ namespace LinuxSampler {
             Mutex DbInstrumentsMutex;
             ListenerList<InstrumentsDb::Listener*> llInstrumentsDbListeners;
             bool InTransaction;
-            WorkerThread InstrumentsDbThread;
+            WorkerPool InstrumentsDbWorkers;
             
             InstrumentsDb();
             ~InstrumentsDb();
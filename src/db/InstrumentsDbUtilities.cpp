@@ -288,6 +288,7 @@ namespace LinuxSampler {
     }
 
     int JobList::AddJob(ScanJob Job) {
+        LockGuard lock(mutex);
         if (Counter + 1 < Counter) Counter = 0;
         else Counter++;
         Job.JobId = Counter;
@@ -299,13 +300,25 @@ namespace LinuxSampler {
         return Job.JobId;
     }
 
-    ScanJob& JobList::GetJobById(int JobId) {
+    ScanJob JobList::GetJobById(int JobId) {
+        LockGuard lock(mutex);
         for (int i = 0; i < Jobs.size(); i++) {
             if (Jobs.at(i).JobId == JobId) return Jobs.at(i);
         }
         
         throw Exception("Invalid job ID: " + ToString(JobId));
     }
+
+    void JobList::UpdateJob(const ScanJob& Job) {
+        LockGuard lock(mutex);
+        for (int i = 0; i < Jobs.size(); i++) {
+            if (Jobs.at(i).JobId != Job.JobId) continue;
+            Jobs.at(i) = Job;
+            return;
+        }
+
+        throw Exception("Invalid job ID: " + ToString(Job.JobId));
+    }
     
     bool AbstractFinder::IsRegex(String Pattern) {
         if(Pattern.find('?') != String::npos) return true;
@@ -590,10 +603,13 @@ namespace LinuxSampler {
 
     void ScanProgress::StatusChanged() {
         InstrumentsDb* db = InstrumentsDb::GetInstrumentsDb();
-        db->Jobs.GetJobById(JobId).FilesTotal = GetTotalFileCount();
-        db->Jobs.GetJobById(JobId).FilesScanned = GetScannedFileCount();
-        db->Jobs.GetJobById(JobId).Scanning = CurrentFile;
-        db->Jobs.GetJobById(JobId).Status = GetStatus();
+        ScanJob job;
+        job.JobId = JobId;
+        job.FilesTotal = GetTotalFileCount();
+        job.FilesScanned = GetScannedFileCount();
+        job.Scanning = CurrentFile;
+        job.Status = GetStatus();
+        db->Jobs.UpdateJob(job);
         
         InstrumentsDb::GetInstrumentsDb()->FireJobStatusChanged(JobId);
     }
@@ -33,6 +33,7 @@
 #include <sqlite3.h>
 
 #include "../common/File.h"
+#include "../common/Mutex.h"
 #include "../common/optional.h"
 
 namespace LinuxSampler {
@@ -131,6 +132,10 @@ namespace LinuxSampler {
             void Copy(const ScanJob&);
     };
     
+    /**
+     * The jobs of the instruments DB. Background jobs run in parallel on
+     * the instruments DB's worker pool, so all access is synchronized.
+     */
     class JobList {
         public:
             JobList() { Counter = 0; }
@@ -143,14 +148,21 @@ namespace LinuxSampler {
             int AddJob(ScanJob Job);
 
             /**
-             * Returns the job with ID JobId.
+             * Returns a copy of the job with ID JobId.
              * @throws Exception If job with ID JobId doesn't exist.
              */
-            ScanJob& GetJobById(int JobId);
+            ScanJob GetJobById(int JobId);
+
+            /**
+             * Replaces the job with the ID of the specified job.
+             * @throws Exception If job with that ID doesn't exist.
+             */
+            void UpdateJob(const ScanJob& Job);
 
         private:
             std::vector<ScanJob> Jobs;
             int Counter;
+            Mutex mutex;
     };
 
     class DirectoryHandler {
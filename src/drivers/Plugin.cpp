@@ -38,7 +38,7 @@ namespace LinuxSampler {
 
         REGISTER_AUDIO_OUTPUT_DRIVER(AudioOutputDevicePlugin);
         REGISTER_AUDIO_OUTPUT_DRIVER_PARAMETER(AudioOutputDevicePlugin, ParameterActive);
-        REGISTER_AUDIO_OUTPUT_DRIVER_PARAMETER(AudioOutputDevicePlugin, ParameterSampleRate);
+        REGISTER_AUDIO_OUTPUT_DRIVER_PARAMETER(AudioOutputDevicePlugin, ParameterSampleRatePlugin);
         REGISTER_AUDIO_OUTPUT_DRIVER_PARAMETER(AudioOutputDevicePlugin, ParameterChannelsPlugin);
         REGISTER_AUDIO_OUTPUT_DRIVER_PARAMETER(AudioOutputDevicePlugin, ParameterFragmentSize);
 
@@ -76,6 +76,97 @@ namespace LinuxSampler {
     }
 
 
+    /*
+      The instrument cache is shared by all plugin instances of the
+      process. As long as at least one plugin instance references an
+      instrument, the instrument is kept in memory, even if no sampler
+      channel is using it for a moment, e.g. while an instance's state
+      is being restored. So many instances referencing the same
+      instrument only load it once.
+    */
+
+    void PluginGlobal::RetainInstrument(const instrument_key_t& Key) {
+        {
+            LockGuard lock(InstrumentCacheMutex);
+            std::map<instrument_key_t, cached_instrument_t>::iterator iter =
+                InstrumentCache.find(Key);
+            if (iter != InstrumentCache.end()) {
+                if (iter->second.RefCount++) return;
+            } else {
+                cached_instrument_t& entry = InstrumentCache[Key];
+                entry.RefCount  = 1;
+                entry.bRetained = false;
+                entry.bHold     = false;
+                entry.bApplying = false;
+            }
+        }
+        ApplyInstrumentMode(Key);
+    }
+
+    void PluginGlobal::ReleaseInstrument(const instrument_key_t& Key) {
+        {
+            LockGuard lock(InstrumentCacheMutex);
+            std::map<instrument_key_t, cached_instrument_t>::iterator iter =
+                InstrumentCache.find(Key);
+            if (iter == InstrumentCache.end() || --iter->second.RefCount) return;
+        }
+        ApplyInstrumentMode(Key);
+    }
+
+    /*
+      Changes the instrument's mode according to its reference count. The
+      mode is changed without holding InstrumentCacheMutex, since
+      SetMode() may have to wait for other instruments being loaded, which
+      would stall all plugin instances. Only one thread at a time changes
+      the mode of an instrument, if the reference count changes meanwhile,
+      that thread applies the new count as well before it returns.
+    */
+    void PluginGlobal::ApplyInstrumentMode(const instrument_key_t& Key) {
+        InstrumentCacheMutex.Lock();
+        while (true) {
+            std::map<instrument_key_t, cached_instrument_t>::iterator iter =
+                InstrumentCache.find(Key);
+            if (iter == InstrumentCache.end() || iter->second.bApplying) break;
+            cached_instrument_t& entry = iter->second;
+            const bool bRetain = entry.RefCount > 0;
+            if (bRetain == entry.bRetained) {
+                if (!bRetain) InstrumentCache.erase(iter);
+                break;
+            }
+            bool bHold = entry.bHold;
+            entry.bApplying = true;
+            InstrumentCacheMutex.Unlock();
+            try {
+                if (bRetain) {
+                    // don't override a mode explicitly chosen by the user
+                    // (e.g. by a MIDI instrument map), ON_DEMAND_HOLD
+                    // doesn't load the instrument immediately
+                    if (Key.first->GetMode(Key.second) == InstrumentManager::ON_DEMAND) {
+                        Key.first->SetMode(Key.second, InstrumentManager::ON_DEMAND_HOLD);
+                        bHold = true;
+                    }
+                } else {
+                    if (bHold &&
+                        Key.first->GetMode(Key.second) == InstrumentManager::ON_DEMAND_HOLD) {
+                        // unloads the instrument if no sampler channel uses it anymore
+                        Key.first->SetMode(Key.second, InstrumentManager::ON_DEMAND);
+                    }
+                    bHold = false;
+                }
+            } catch (Exception e) {
+                e.PrintMessage();
+            }
+            InstrumentCacheMutex.Lock();
+            // the entry is not erased while bApplying is set
+            cached_instrument_t& applied = InstrumentCache[Key];
+            applied.bRetained = bRetain;
+            applied.bHold     = bHold;
+            applied.bApplying = false;
+        }
+        InstrumentCacheMutex.Unlock();
+    }
+
+
 // *************** EventThread ***************
 // *
 
@@ -118,17 +209,31 @@ namespace LinuxSampler {
     }
 
     void Plugin::Init(int SampleRate, int FragmentSize, int Channels) {
-        if (pAudioDevice && SampleRate == pAudioDevice->SampleRate() &&
-            FragmentSize == pAudioDevice->MaxSamplesPerCycle()) {
-            return; // nothing has changed
+        if (pAudioDevice && FragmentSize <= pAudioDevice->MaxSamplesPerCycle()) {
+            // The device's buffers and the samples already cached in RAM
+            // are large enough for the new fragment size, so we keep the
+            // device (and thus all loaded instruments) and just let the
+            // engines reconnect in case the sample rate changed. Render()
+            // may always be called with less than MaxSamplesPerCycle().
+            pAudioDevice->SetSampleRate(SampleRate);
+            return;
         }
 
+        // If the fragment size grew beyond what the device was created
+        // for, the instruments' RAM cached samples need a larger silence
+        // extension, so in that case we rebuild everything and reload the
+        // state.
+
         String oldState;
         if (pAudioDevice) {
             oldState = GetState();
             RemoveChannels();
             AudioOutputDeviceFactory::DestroyPrivate(pAudioDevice);
         }
+        // Instruments shared between the plugin instances are cached with a
+        // silence extension sufficient for the largest fragment size of all
+        // plugin devices (see InstrumentManagerBase::GetMaxSamplesPerCycle()),
+        // so each device only needs to be as large as its own fragments.
         std::map<String, String> params;
         params["SAMPLERATE"] = ToString(SampleRate);
         params["FRAGMENTSIZE"] = ToString(FragmentSize);
@@ -155,6 +260,7 @@ namespace LinuxSampler {
 
     Plugin::~Plugin() {
         RemoveChannels();
+        ReleaseUnusedInstruments();
         if (pAudioDevice) AudioOutputDeviceFactory::DestroyPrivate(pAudioDevice);
         if (pMidiDevice) MidiInputDeviceFactory::DestroyPrivate(pMidiDevice);
         if (bPreInitDone) {
@@ -283,6 +389,10 @@ namespace LinuxSampler {
     void Plugin::RemoveChannels() {
         if(global == NULL) return;
 
+        // keep the instruments in the shared cache until the new state
+        // has been applied
+        RetainInstruments();
+
         std::map<uint, SamplerChannel*> channels = global->pSampler->GetSamplerChannels();
 
         for (std::map<uint, SamplerChannel*>::iterator iter = channels.begin() ;
@@ -293,7 +403,11 @@ namespace LinuxSampler {
         }
     }
 
-    bool Plugin::SetState(String State) {
+    /*
+      If bMapPaths is false, the instrument file names in the state
+      are expected to be already converted by ResolveStatePaths().
+    */
+    bool Plugin::SetState(String State, bool bMapPaths) {
         RemoveChannels();
         MidiInstrumentMapper::RemoveAllMaps();
 
@@ -351,8 +465,12 @@ namespace LinuxSampler {
                 }
                 if (!filename.empty() && index != -1) {
                     InstrumentManager::instrument_id_t id;
-                    id.FileName = PathFromState(filename);
+                    id.FileName = bMapPaths ? PathFromState(filename) : filename;
                     id.Index    = index;
+                    // mark the channel as loading right away, so
+                    // GetLoadingProgress() and GetState() already see
+                    // the instrument while it is still queued
+                    engine_channel->PrepareLoadInstrument(id.FileName.c_str(), id.Index);
                     InstrumentManager::LoadInstrumentInBackground(id, engine_channel);
                 }
                 if (solo) engine_channel->SetSolo(solo);
@@ -414,9 +532,135 @@ namespace LinuxSampler {
             }
         }
 
+        RetainInstruments();
+        ReleaseUnusedInstruments();
+
         return true;
     }
 
+    /*
+      Adds the instruments of this plugin's sampler channels to the
+      set of instruments this plugin instance holds in the shared
+      instrument cache.
+    */
+    void Plugin::RetainInstruments() {
+        if (!global) return;
+
+        std::map<uint, SamplerChannel*> channels = global->pSampler->GetSamplerChannels();
+        for (std::map<uint, SamplerChannel*>::iterator iter = channels.begin() ;
+             iter != channels.end() ; iter++) {
+            SamplerChannel* channel = iter->second;
+            if (channel->GetAudioOutputDevice() != pAudioDevice) continue;
+            EngineChannel* engine_channel = channel->GetEngineChannel();
+            if (!engine_channel || !engine_channel->GetEngine() ||
+                engine_channel->InstrumentFileName().empty() ||
+                engine_channel->InstrumentStatus() < 0) continue;
+
+            PluginGlobal::instrument_key_t key;
+            key.first = engine_channel->GetEngine()->GetInstrumentManager();
+            key.second.FileName = engine_channel->InstrumentFileName();
+            key.second.Index = engine_channel->InstrumentIndex();
+            if (RetainedInstruments.insert(key).second) {
+                global->RetainInstrument(key);
+            }
+        }
+    }
+
+    /*
+      Releases the instruments in the shared instrument cache which
+      are no longer used by this plugin's sampler channels.
+    */
+    void Plugin::ReleaseUnusedInstruments() {
+        if (!global) return;
+
+        std::set<PluginGlobal::instrument_key_t> used;
+        std::map<uint, SamplerChannel*> channels = global->pSampler->GetSamplerChannels();
+        for (std::map<uint, SamplerChannel*>::iterator iter = channels.begin() ;
+             iter != channels.end() ; iter++) {
+            SamplerChannel* channel = iter->second;
+            if (channel->GetAudioOutputDevice() != pAudioDevice) continue;
+            EngineChannel* engine_channel = channel->GetEngineChannel();
+            if (!engine_channel || !engine_channel->GetEngine()) continue;
+
+            PluginGlobal::instrument_key_t key;
+            key.first = engine_channel->GetEngine()->GetInstrumentManager();
+            key.second.FileName = engine_channel->InstrumentFileName();
+            key.second.Index = engine_channel->InstrumentIndex();
+            used.insert(key);
+        }
+
+        std::set<PluginGlobal::instrument_key_t>::iterator iter = RetainedInstruments.begin();
+        while (iter != RetainedInstruments.end()) {
+            if (used.find(*iter) == used.end()) {
+                global->ReleaseInstrument(*iter);
+                RetainedInstruments.erase(iter++);
+            } else {
+                ++iter;
+            }
+        }
+    }
+
+    /*
+      Returns a copy of the given state text with all instrument file
+      names converted by PathFromState(). This allows a plugin to map
+      the paths while the host's path mapping is available and to
+      apply the state later on with SetState(State, false).
+    */
+    String Plugin::ResolveStatePaths(const String& State) {
+        std::stringstream in(State);
+        std::stringstream out;
+        String line;
+
+        // global volume
+        if (std::getline(in, line)) out << line << '\n';
+
+        while (std::getline(in, line)) {
+            std::istringstream l(line);
+            int type;
+            float volume;
+            if (l >> type && type <= 16 && l >> volume) { // sampler channel
+                const std::streamoff pos = l.tellg();
+                if (pos >= 0 && size_t(pos) + 1 < line.size()) {
+                    out << line.substr(0, pos + 1) <<
+                        PathFromState(line.substr(pos + 1)) << '\n';
+                } else { // no instrument file
+                    out << line << '\n';
+                }
+                // the channel's second line has no type integer
+                if (std::getline(in, line)) out << line << '\n';
+            } else {
+                out << line << '\n';
+            }
+        }
+        return out.str();
+    }
+
+    /**
+     * Returns the overall progress of the instruments currently being
+     * loaded on this plugin's sampler channels, as value between 0 and
+     * 100. If no instrument is being loaded, 100 is returned. This
+     * method is not real-time safe.
+     */
+    int Plugin::GetLoadingProgress() {
+        if (!global) return 100;
+
+        int sum = 0;
+        int count = 0;
+        std::map<uint, SamplerChannel*> channels = global->pSampler->GetSamplerChannels();
+        for (std::map<uint, SamplerChannel*>::iterator iter = channels.begin() ;
+             iter != channels.end() ; iter++) {
+            SamplerChannel* channel = iter->second;
+            if (channel->GetAudioOutputDevice() != pAudioDevice) continue;
+            EngineChannel* engine_channel = channel->GetEngineChannel();
+            if (!engine_channel || engine_channel->InstrumentFileName().empty()) continue;
+            const int status = engine_channel->InstrumentStatus();
+            if (status < 0) continue; // no instrument or loading failed
+            sum += status;
+            count++;
+        }
+        return count ? sum / count : 100;
+    }
+
     void Plugin::DestroyDevice(AudioOutputDevicePlugin* pDevice) {
         AudioOutputDeviceFactory::DestroyPrivate(pDevice);
     }
@@ -23,6 +23,8 @@
 
 #include "../Sampler.h"
 #include "../common/Thread.h"
+#include "../common/Mutex.h"
+#include "../engines/InstrumentManager.h"
 #include "../network/lscpserver.h"
 #include "audio/AudioOutputDevicePlugin.h"
 #include "midi/MidiInputDevicePlugin.h"
@@ -36,11 +38,28 @@ namespace LinuxSampler {
         PluginGlobal();
         virtual ~PluginGlobal();
 
+        /// Identifies an instrument in the shared instrument cache.
+        typedef std::pair<InstrumentManager*, InstrumentManager::instrument_id_t> instrument_key_t;
+
+        void RetainInstrument(const instrument_key_t& Key);
+        void ReleaseInstrument(const instrument_key_t& Key);
+
         Sampler* pSampler;
         int RefCount;
         LSCPServer* pLSCPServer;
     private:
+        struct cached_instrument_t {
+            int  RefCount;  ///< number of plugin instances referencing the instrument
+            bool bRetained; ///< whether the mode change for RefCount > 0 was applied
+            bool bHold;     ///< whether we changed the instrument's mode to ON_DEMAND_HOLD
+            bool bApplying; ///< whether a thread is currently changing the instrument's mode
+        };
+
+        void ApplyInstrumentMode(const instrument_key_t& Key);
+
         EventThread* pEventThread;
+        std::map<instrument_key_t, cached_instrument_t> InstrumentCache;
+        Mutex InstrumentCacheMutex;
     };
 
     class EventThread : public Thread {
@@ -74,7 +93,9 @@ namespace LinuxSampler {
         
         void InitState();
         String GetState();
-        bool SetState(String State);
+        bool SetState(String State, bool bMapPaths = true);
+        String ResolveStatePaths(const String& State);
+        int GetLoadingProgress();
         void RemoveChannels();
         void DestroyDevice(AudioOutputDevicePlugin* pDevice);
         void DestroyDevice(MidiInputDevicePlugin* pDevice);
@@ -84,7 +105,11 @@ namespace LinuxSampler {
         static PluginGlobal* global;
 
     private:
+        void RetainInstruments();
+        void ReleaseUnusedInstruments();
+
         bool bPreInitDone;
+        std::set<PluginGlobal::instrument_key_t> RetainedInstruments;
     };
 }
 
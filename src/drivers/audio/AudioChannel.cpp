@@ -35,6 +35,20 @@
 
 namespace LinuxSampler {
 
+#if CONFIG_RENDER_BLOCK_SIZE
+    /**
+     * Allocates the block buffer of a channel with a regular audio buffer of
+     * @a BufferSize sample points. It has to hold at least one render block,
+     * even if the channel's buffer is smaller or provided later on by the
+     * driver (e.g. by plugin hosts, which create channels with a buffer size
+     * of 0).
+     */
+    static float* AllocBlockBuffer(uint BufferSize) {
+        const uint size = (BufferSize > CONFIG_RENDER_BLOCK_SIZE) ? BufferSize : CONFIG_RENDER_BLOCK_SIZE;
+        return (float *) Thread::allocAlignedMem(16,size*sizeof(float));
+    }
+#endif
+
     /**
      * Create real channel.
      *
@@ -47,6 +61,11 @@ namespace LinuxSampler {
         this->uiBufferSize       = BufferSize;
         this->pMixChannel        = NULL;
         this->UsesExternalBuffer = false;
+        #if CONFIG_RENDER_BLOCK_SIZE
+        this->pBlockBuffer       = AllocBlockBuffer(BufferSize);
+        #else
+        this->pBlockBuffer       = NULL;
+        #endif
 
         Parameters["NAME"]           = new ParameterName("Channel " + ToString(ChannelNr));
         Parameters["IS_MIX_CHANNEL"] = new ParameterIsMixChannel(false);
@@ -67,6 +86,11 @@ namespace LinuxSampler {
         this->uiBufferSize       = BufferSize;
         this->pMixChannel        = NULL;
         this->UsesExternalBuffer = true;
+        #if CONFIG_RENDER_BLOCK_SIZE
+        this->pBlockBuffer       = AllocBlockBuffer(BufferSize);
+        #else
+        this->pBlockBuffer       = NULL;
+        #endif
 
         Parameters["NAME"]           = new ParameterName("Channel " + ToString(ChannelNr));
         Parameters["IS_MIX_CHANNEL"] = new ParameterIsMixChannel(false);
@@ -87,6 +111,8 @@ namespace LinuxSampler {
         this->uiBufferSize       = pMixChannelDestination->uiBufferSize;
         this->pMixChannel        = pMixChannelDestination;
         this->UsesExternalBuffer = true;
+        // write to the destination's block buffer while rendering blocks
+        this->pBlockBuffer       = pMixChannelDestination->BlockBuffer();
 
         Parameters["NAME"]           = new ParameterName("Channel " + ToString(ChannelNr));
         Parameters["IS_MIX_CHANNEL"] = new ParameterIsMixChannel(true);
@@ -102,6 +128,7 @@ namespace LinuxSampler {
         std::map<String,DeviceRuntimeParameter*>::iterator iter = Parameters.begin();
         while (iter != Parameters.end()) { delete iter->second; iter++; }
         if (!UsesExternalBuffer) Thread::freeAlignedMem(pBuffer);
+        if (pBlockBuffer && !pMixChannel) Thread::freeAlignedMem(pBlockBuffer);
     }
 
     /**
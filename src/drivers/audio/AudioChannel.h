@@ -89,6 +89,8 @@ namespace LinuxSampler {
             // methods
             inline float*        Buffer()     { return pBuffer;      } ///< Audio signal buffer
             void SetBuffer(float* pBuffer)    { this->pBuffer = pBuffer; }
+            inline float*        BlockBuffer() { return pBlockBuffer; } ///< Buffer the audio output device renders fixed size blocks to, NULL if the sampler was compiled without CONFIG_RENDER_BLOCK_SIZE.
+            inline void          SwapBlockBuffer() { float* p = pBuffer; pBuffer = pBlockBuffer; pBlockBuffer = p; } ///< Exchange the audio signal buffer with the block buffer.
             inline AudioChannel* MixChannel() { return pMixChannel;  } ///< In case this channel is a mix channel, then it will return a pointer to the real channel this channel refers to, NULL otherwise.
             inline void          Clear()      { memset(pBuffer, 0, uiBufferSize * sizeof(float)); } ///< Reset audio buffer with silence
             inline void          Clear(uint Samples) { memset(pBuffer, 0, Samples * sizeof(float)); } ///< Reset audio buffer with silence
@@ -111,6 +113,7 @@ namespace LinuxSampler {
             uint          uiBufferSize;
             AudioChannel* pMixChannel;
             bool          UsesExternalBuffer;
+            float*        pBlockBuffer;
     };
 }
 
@@ -25,6 +25,7 @@
 #include "AudioOutputDevice.h"
 #include "../../common/global_private.h"
 #include "../../common/IDGenerator.h"
+#include "../../common/RTMath.h"
 
 namespace LinuxSampler {
 
@@ -185,6 +186,8 @@ namespace LinuxSampler {
         : EnginesReader(Engines) {
         this->Parameters = DriverParameters;
         EffectChainIDs = new IDGenerator();
+        uiBlockPos = CONFIG_RENDER_BLOCK_SIZE; // no pending block yet
+        uiRenderTimeStamp = uiLastCallTimeStamp = RTMath::CreateTimeStamp();
     }
 
     AudioOutputDevice::~AudioOutputDevice() {
@@ -337,12 +340,81 @@ namespace LinuxSampler {
     }
     
     float AudioOutputDevice::latency() {
-        return float(MaxSamplesPerCycle()) / float(SampleRate());
+        return float(MaxSamplesPerCycle() + RenderLatency()) / float(SampleRate());
+    }
+
+    uint AudioOutputDevice::RenderLatency() {
+        #if CONFIG_RENDER_BLOCK_SIZE
+        // RenderAudio() only renders in blocks if they fit into a fragment
+        if (CONFIG_RENDER_BLOCK_SIZE <= MaxSamplesPerCycle())
+            return CONFIG_RENDER_BLOCK_SIZE;
+        #endif
+        return 0;
     }
 
     int AudioOutputDevice::RenderAudio(uint Samples) {
         if (Channels.empty()) return 0;
+        #if CONFIG_RENDER_BLOCK_SIZE
+        // the engines' and effects' buffers are only MaxSamplesPerCycle()
+        // large, so fall back to rendering whole fragments if a block
+        // would not fit
+        if (CONFIG_RENDER_BLOCK_SIZE <= MaxSamplesPerCycle())
+            return RenderBlocks(Samples);
+        #endif
+        uiRenderTimeStamp = uiLastCallTimeStamp = RTMath::CreateTimeStamp();
+        return RenderFragment(Samples);
+    }
+
+    /**
+     * Renders the requested amount of sample points in blocks of exactly
+     * CONFIG_RENDER_BLOCK_SIZE sample points. Larger driver fragments are
+     * split into several blocks, smaller ones are served from the remainder
+     * of the last rendered block, so the engines' and effects' per call
+     * overhead does not depend on the driver's fragment size.
+     *
+     * Each block is rendered into the channels' block buffers and then
+     * copied to the driver's buffers. The remainder of a block is delivered
+     * with the next call(s), which adds up to one block of latency.
+     */
+    int AudioOutputDevice::RenderBlocks(uint Samples) {
+        const uint BlockSize = CONFIG_RENDER_BLOCK_SIZE;
+        const uint32_t now = RTMath::CreateTimeStamp();
+        const uint32_t elapsed = now - uiLastCallTimeStamp;
+        const std::vector<AudioChannel*>::iterator beginChannels = Channels.begin();
+        const std::vector<AudioChannel*>::iterator endChannels   = Channels.end();
+        std::vector<AudioChannel*>::iterator iterChannels;
+        int result = 0;
+
+        for (uint done = 0; done < Samples; ) {
+            if (uiBlockPos == BlockSize) { // render next block
+                // spread the blocks' time stamps over the driver's period, so
+                // events still get mapped to the right block and position
+                const uint due = (done + BlockSize < Samples) ? done + BlockSize : Samples;
+                uiRenderTimeStamp = uiLastCallTimeStamp + uint32_t(uint64_t(elapsed) * due / Samples);
+                for (iterChannels = beginChannels; iterChannels != endChannels; ++iterChannels)
+                    (*iterChannels)->SwapBlockBuffer();
+                const int res = RenderFragment(BlockSize);
+                for (iterChannels = beginChannels; iterChannels != endChannels; ++iterChannels)
+                    (*iterChannels)->SwapBlockBuffer();
+                if (res != 0) result = res;
+                uiBlockPos = 0;
+            }
+            // deliver as much of the current block as requested
+            const uint n = (BlockSize - uiBlockPos < Samples - done) ? BlockSize - uiBlockPos : Samples - done;
+            for (iterChannels = beginChannels; iterChannels != endChannels; ++iterChannels) {
+                AudioChannel* pChannel = *iterChannels;
+                if (pChannel->MixChannel()) continue; // shares its destination's buffers
+                memcpy(pChannel->Buffer() + done, pChannel->BlockBuffer() + uiBlockPos, n * sizeof(float));
+            }
+            uiBlockPos += n;
+            done       += n;
+        }
+
+        uiLastCallTimeStamp = now;
+        return result;
+    }
 
+    int AudioOutputDevice::RenderFragment(uint Samples) {
         // reset all channels with silence
         {
             std::vector<AudioChannel*>::iterator iterChannels = Channels.begin();
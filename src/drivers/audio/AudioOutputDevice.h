@@ -199,6 +199,31 @@ namespace LinuxSampler {
              */
             virtual float latency();
 
+            /**
+             * Amount of sample points the sampler itself delays the audio
+             * signal, on top of the driver's buffering. If the sampler was
+             * compiled with a fixed render block size
+             * (CONFIG_RENDER_BLOCK_SIZE), this is one block, as long as a
+             * block fits into the device's fragments, otherwise it is 0.
+             *
+             * Drivers and host plugins report this to the audio system or
+             * host, so it can be compensated.
+             */
+            uint RenderLatency();
+
+            /**
+             * Time stamp (as returned by RTMath::CreateTimeStamp()) at which
+             * the end of the audio fragment currently being rendered by the
+             * connected engines is due. The engines use it to map the time
+             * stamps of incoming events to sample points of the fragment.
+             *
+             * If the sampler was compiled with a fixed render block size
+             * (CONFIG_RENDER_BLOCK_SIZE), this is interpolated for each
+             * block over the driver's current period, otherwise it is simply
+             * the time the driver called RenderAudio().
+             */
+            uint32_t RenderTimeStamp() const { return uiRenderTimeStamp; }
+
 
 
             /////////////////////////////////////////////////////////////////
@@ -365,6 +390,13 @@ namespace LinuxSampler {
 
             friend class AudioOutputDeviceFactory; // allow AudioOutputDeviceFactory class to destroy audio devices
 
+        private:
+            uint     uiBlockPos;              ///< Amount of sample points of the current render block already delivered to the driver.
+            uint32_t uiRenderTimeStamp;       ///< See RenderTimeStamp().
+            uint32_t uiLastCallTimeStamp;     ///< Time stamp of the previous RenderAudio() call.
+
+            int RenderFragment(uint Samples);
+            int RenderBlocks(uint Samples);
     };
 
     /**
@@ -512,6 +512,7 @@ namespace LinuxSampler {
      * @throws AudioOutputException  if output device cannot be opened
      */
     AudioOutputDeviceAlsa::AudioOutputDeviceAlsa(std::map<String,DeviceCreationParameter*> Parameters) : AudioOutputDevice(Parameters), Thread(true, true, 1, 0) {
+        SetRole(ROLE_AUDIO);
         pcm_handle           = NULL;
         stream               = SND_PCM_STREAM_PLAYBACK;
         this->uiAlsaChannels = ((DeviceCreationParameterInt*)Parameters["CHANNELS"])->ValueAsInt();
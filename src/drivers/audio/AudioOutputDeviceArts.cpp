@@ -85,6 +85,7 @@ namespace LinuxSampler {
      * @throws AudioOutputException  if output device cannot be opened
      */
     AudioOutputDeviceArts::AudioOutputDeviceArts(std::map<String,DeviceCreationParameter*> Parameters) : AudioOutputDevice(Parameters), Thread(true, true, 1, 0) {
+        SetRole(ROLE_AUDIO);
         uiArtsChannels = ((DeviceCreationParameterInt*)Parameters["CHANNELS"])->ValueAsInt();
         uiSampleRate   = ((DeviceCreationParameterInt*)Parameters["SAMPLERATE"])->ValueAsInt();
         String name    = ((DeviceCreationParameterString*)Parameters["NAME"])->ValueAsString();
@@ -84,6 +84,7 @@ namespace LinuxSampler {
     AudioOutputDeviceCoreAudio::AudioOutputDeviceCoreAudio (
                     std::map<String,DeviceCreationParameter*> Parameters
     ) : AudioOutputDevice(Parameters), Thread(true, true, 1, 0), CurrentDevice(0) {
+        SetRole(ROLE_AUDIO);
 
         dmsg(2,("AudioOutputDeviceCoreAudio::AudioOutputDeviceCoreAudio()\n"));
         if(CAAudioDeviceListModel::GetModel()->GetOutputDeviceCount() < 1) {
@@ -265,9 +265,27 @@ namespace LinuxSampler {
             static_cast<AudioChannelJack*>(Channels[i])->UpdateJackBuffer(size);
     }
     
+#if HAVE_JACK_SET_LATENCY_CALLBACK
+    /**
+     * Reports the delay added by rendering in fixed size blocks (if any) as
+     * latency of our output ports, so JACK and its clients can compensate
+     * it. Called by JACK whenever the latencies of the graph change.
+     */
+    void AudioOutputDeviceJack::UpdateJackLatencies(jack_latency_callback_mode_t mode) {
+        if (mode != JackCaptureLatency) return;
+        jack_latency_range_t range;
+        range.min = range.max = RenderLatency();
+        for (size_t i = 0; i < Channels.size(); ++i)
+            jack_port_set_latency_range(
+                static_cast<AudioChannelJack*>(Channels[i])->hJackPort,
+                JackCaptureLatency, &range
+            );
+    }
+#endif
+
     float AudioOutputDeviceJack::latency() {
         if (!hJackClient) return -1;
-        const float size = jack_get_buffer_size(hJackClient);
+        const float size = jack_get_buffer_size(hJackClient) + RenderLatency();
         const float rate = jack_get_sample_rate(hJackClient);
         return size / rate;
     }
@@ -372,6 +390,16 @@ namespace LinuxSampler {
         return 0;
     }
     
+#if HAVE_JACK_SET_LATENCY_CALLBACK
+    void JackClient::libjackLatencyCallback(jack_latency_callback_mode_t mode, void *arg) {
+        JackClient* client = static_cast<JackClient*>(arg);
+        const config_t& config = client->ConfigReader.Lock();
+        if (config.AudioDevice)
+            config.AudioDevice->UpdateJackLatencies(mode);
+        client->ConfigReader.Unlock();
+    }
+#endif
+
     void JackClient::addListener(JackListener* listener) {
         jackListeners.push_back(listener);
     }
@@ -427,6 +455,9 @@ namespace LinuxSampler {
 #endif
         jack_set_buffer_size_callback(hJackClient, libjackBufferSizeCallback, this);
         jack_set_sample_rate_callback(hJackClient, libjackSampleRateCallback, this);
+#if HAVE_JACK_SET_LATENCY_CALLBACK
+        jack_set_latency_callback(hJackClient, libjackLatencyCallback, this);
+#endif
         
         if (jack_activate(hJackClient))
             throw Exception("Jack: Cannot activate Jack client.");
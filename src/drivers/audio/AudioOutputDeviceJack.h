@@ -157,6 +157,9 @@ namespace LinuxSampler {
 
             int Process(uint Samples);  // FIXME: should be private
             void UpdateJackBuffers(uint size);
+            #if HAVE_JACK_SET_LATENCY_CALLBACK
+            void UpdateJackLatencies(jack_latency_callback_mode_t mode);
+            #endif
             void addListener(JackListener* listener);
             jack_client_t* jackClientHandle();
         protected:
@@ -220,6 +223,9 @@ namespace LinuxSampler {
 #endif
             static int libjackSampleRateCallback(jack_nframes_t nframes, void *arg);
             static int libjackBufferSizeCallback(jack_nframes_t nframes, void *arg);
+#if HAVE_JACK_SET_LATENCY_CALLBACK
+            static void libjackLatencyCallback(jack_latency_callback_mode_t mode, void *arg);
+#endif
     };
     
     /**
@@ -32,6 +32,14 @@ namespace LinuxSampler {
     }
 
 
+// *************** ParameterSampleRatePlugin  ***************
+// *
+
+    void AudioOutputDevicePlugin::ParameterSampleRatePlugin::ForceSetValue(int rate) {
+        iVal = rate;
+    }
+
+
 // *************** ParameterChannelsPlugin  ***************
 // *
 
@@ -173,4 +181,12 @@ namespace LinuxSampler {
         static_cast<ParameterChannelsPlugin*>(
             Parameters["CHANNELS"])->ForceSetValue(int(Channels.size()));
     }
+
+    void AudioOutputDevicePlugin::SetSampleRate(uint SampleRate) {
+        if (SampleRate == uiSampleRate) return;
+        uiSampleRate = SampleRate;
+        static_cast<ParameterSampleRatePlugin*>(
+            Parameters["SAMPLERATE"])->ForceSetValue(int(SampleRate));
+        ReconnectAll();
+    }
 }
@@ -47,6 +47,16 @@ namespace LinuxSampler {
             friend class AudioOutputDevicePlugin;
         };
 
+        /**
+         * Device Parameter 'SAMPLERATE'
+         */
+        class ParameterSampleRatePlugin : public ParameterSampleRate {
+        public:
+            ParameterSampleRatePlugin() : ParameterSampleRate() { }
+            ParameterSampleRatePlugin(String s) : ParameterSampleRate(s) { }
+            void ForceSetValue(int rate);
+        };
+
         /**
          * Device Parameter 'CHANNELS'
          */
@@ -107,6 +117,16 @@ namespace LinuxSampler {
         void AddChannels(int newChannels);
         void RemoveChannel(AudioChannel* pChannel);
 
+        /**
+         * Changes the sample rate of this device in place. All engines
+         * connected to this device will be reconnected, so they can
+         * update their sample rate dependent data, but already loaded
+         * instruments are kept.
+         *
+         * @param SampleRate - new sample rate
+         */
+        void SetSampleRate(uint SampleRate);
+
     private:
         uint uiSampleRate;
         uint uiMaxSamplesPerCycle;
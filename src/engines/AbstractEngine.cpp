@@ -73,6 +73,24 @@ namespace LinuxSampler {
         return pEngine;
     }
 
+    /**
+     * Returns statistics about voices of all engine instances, which were
+     * inaudible, and thus not rendered or freed early.
+     */
+    AbstractEngine::culling_statistics_t AbstractEngine::GetCullingStatistics() {
+        culling_statistics_t stats;
+        stats.InaudibleVoices = stats.CulledVoices = 0;
+        std::map<Format, std::map<AudioOutputDevice*,AbstractEngine*> >::iterator itFormat;
+        for (itFormat = engines.begin(); itFormat != engines.end(); ++itFormat) {
+            std::map<AudioOutputDevice*,AbstractEngine*>::iterator itEngine;
+            for (itEngine = itFormat->second.begin(); itEngine != itFormat->second.end(); ++itEngine) {
+                stats.InaudibleVoices += atomic_read(&itEngine->second->InaudibleVoiceCount);
+                stats.CulledVoices    += atomic_read(&itEngine->second->CulledVoiceCount);
+            }
+        }
+        return stats;
+    }
+
     AbstractEngine::AbstractEngine() {
         pAudioOutputDevice = NULL;
         pEventGenerator    = NULL;
@@ -85,6 +103,9 @@ namespace LinuxSampler {
         RandomSeed         = 0;
         pDedicatedVoiceChannelLeft = pDedicatedVoiceChannelRight = NULL;
         pScriptVM          = NULL;
+        InaudibleVoiceCountTemp = 0;
+        atomic_set(&InaudibleVoiceCount, 0);
+        atomic_set(&CulledVoiceCount, 0);
     }
 
     AbstractEngine::~AbstractEngine() {
@@ -436,16 +457,9 @@ namespace LinuxSampler {
         event.pMidiInputPort    = pSender;
         if (pEventQueue->write_space() > 0) {
             if (pSysexBuffer->write_space() >= Size) {
-                // copy sysex data to input buffer
-                uint toWrite = Size;
-                uint8_t* pPos = (uint8_t*) pData;
-                while (toWrite) {
-                    const uint writeNow = RTMath::Min(toWrite, pSysexBuffer->write_space_to_end());
-                    pSysexBuffer->write(pPos, writeNow);
-                    toWrite -= writeNow;
-                    pPos    += writeNow;
-
-                }
+                // copy sysex data to input buffer (write() handles the
+                // buffer boundary by itself and publishes all at once)
+                pSysexBuffer->write((uint8_t*) pData, Size);
                 // finally place sysex event into input event queue
                 pEventQueue->push(&event);
             }
@@ -51,6 +51,12 @@ namespace LinuxSampler {
             static AbstractEngine* AcquireEngine(AbstractEngineChannel* pChannel, AudioOutputDevice* pDevice);
             static void FreeEngine(AbstractEngineChannel* pChannel, AudioOutputDevice* pDevice);
 
+            struct culling_statistics_t {
+                int InaudibleVoices; ///< Voices of all engines which were not rendered in the last audio fragment, because they were inaudible.
+                int CulledVoices;    ///< Voices of all engines which were freed early because they became inaudible, since the engines were created.
+            };
+            static culling_statistics_t GetCullingStatistics();
+
             AbstractEngine();
             virtual ~AbstractEngine();
 
@@ -129,6 +135,9 @@ namespace LinuxSampler {
             sched_time_t               FrameTime;             ///< Scheduler time of the 1st sample point of the current audio fragment cycle. This is a consecutive sample point counter for the engine which proceeds (beyond fragment boundaries) until the engine is explicitly reset for some reason.
             int                        ActiveVoiceCountMax;   ///< the maximum voice usage since application start
             atomic_t                   ActiveVoiceCount;      ///< number of currently active voices
+            atomic_t                   InaudibleVoiceCount;   ///< number of voices which were not rendered in the last audio fragment, because they were inaudible (see GLOBAL_VOICE_CULL_THRESHOLD)
+            int                        InaudibleVoiceCountTemp; ///< number of inaudible voices (for internal usage, will be used for incrementation)
+            atomic_t                   CulledVoiceCount;      ///< number of voices which were freed early because they became inaudible, since this engine was created
             int                        VoiceSpawnsLeft;       ///< We only allow CONFIG_MAX_VOICES voices to be spawned per audio fragment, we use this variable to ensure this limit.
             InstrumentScriptVM*        pScriptVM; ///< Real-time instrument script virtual machine runner for this engine.
 
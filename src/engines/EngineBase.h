@@ -142,7 +142,7 @@ namespace LinuxSampler {
                 ProcessSuspensionsChanges();
 
                 // update time of start and end of this audio fragment (as events' time stamps relate to this)
-                pEventGenerator->UpdateFragmentTime(Samples);
+                pEventGenerator->UpdateFragmentTime(Samples, pAudioOutputDevice->RenderTimeStamp());
 
                 // We only allow the given maximum number of voices to be spawned
                 // in each audio fragment. All subsequent request for spawning new
@@ -174,6 +174,7 @@ namespace LinuxSampler {
 
                 // reset internal voice counter (just for statistic of active voices)
                 ActiveVoiceCountTemp = 0;
+                InaudibleVoiceCountTemp = 0;
 
                 HandleInstrumentChanges();
 
@@ -212,6 +213,7 @@ namespace LinuxSampler {
                 // just some statistics about this engine instance
                 SetVoiceCount(ActiveVoiceCountTemp);
                 if (VoiceCount() > ActiveVoiceCountMax) ActiveVoiceCountMax = VoiceCount();
+                atomic_set(&InaudibleVoiceCount, InaudibleVoiceCountTemp);
 
                 // in case regions were previously suspended and we killed voices
                 // with disk streams due to that, check if those streams have finally
@@ -1376,6 +1378,7 @@ namespace LinuxSampler {
                                 }
                             }
                         } else { // voice reached end, is now inactive
+                            itNewVoice->VoiceFreed();
                             pEngineChannel->FreeVoice(itNewVoice); // remove voice from the list of active voices
                         }
                     }
@@ -2009,6 +2012,7 @@ namespace LinuxSampler {
                 // while it's reseting
                 bool sysexDisabled = MidiInputPort::RemoveSysexListener(this);
                 SetVoiceCount(0);
+                atomic_set(&InaudibleVoiceCount, 0);
                 ActiveVoiceCountMax = 0;
 
                 // reset voice stealing parameters
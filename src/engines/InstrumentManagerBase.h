@@ -117,6 +117,28 @@ namespace LinuxSampler {
                 }
             }
 
+            /**
+             * Caches the initial sample points of the given region's sample
+             * (and possibly of related regions' samples), if the instrument
+             * manager defers caching until a region is actually triggered
+             * (see CONFIG_LAZY_SAMPLE_LOADING). Called by the disk thread.
+             * The region's instrument might already have been unloaded, so
+             * implementations must check whether @a pRegion is still valid
+             * before accessing it. The default implementation does nothing.
+             */
+            virtual void CacheRegion(R* pRegion) { }
+
+            /**
+             * Caches the next of the samples that CacheRegion() scheduled
+             * for caching later on (e.g. samples of related regions), if
+             * any. Called by the disk thread once per iteration, so it can
+             * refill its streams in between. The default implementation
+             * does nothing.
+             *
+             * @returns true if a sample was cached
+             */
+            virtual bool CacheNextScheduledSample() { return false; }
+
             virtual InstrumentManager::mode_t GetMode(const InstrumentManager::instrument_id_t& ID) OVERRIDE {
                 return static_cast<InstrumentManager::mode_t>(ResourceManager<instrument_id_t, I>::AvailabilityMode(ID));
             }
@@ -168,7 +190,30 @@ namespace LinuxSampler {
                 // try to resolve the audio device context
                 AbstractEngineChannel* pEngineChannel = dynamic_cast<AbstractEngineChannel*>(pConsumer);
                 AudioOutputDevice* pDevice = pEngineChannel ? pEngineChannel->GetAudioOutputDeviceSafe() : 0;
-                return pDevice ? pDevice->MaxSamplesPerCycle() : DefaultMaxSamplesPerCycle();
+                return GetMaxSamplesPerCycle(pDevice);
+            }
+
+            /**
+             * Returns the max. samples per cycle value the instruments used
+             * with the given audio device have to be cached for. The
+             * (non-autonomous) audio devices of host plugins each keep the
+             * fragment size of their plugin instance, but all plugin
+             * instances of the process share their instruments. So for
+             * those devices the largest value of all plugin devices is
+             * returned, which avoids reloading an instrument when another
+             * plugin instance with a larger fragment size uses it.
+             */
+            uint GetMaxSamplesPerCycle(AudioOutputDevice* pDevice) {
+                if (!pDevice) return DefaultMaxSamplesPerCycle();
+                uint samples = pDevice->MaxSamplesPerCycle();
+                if (pDevice->isAutonomousDevice()) return samples;
+                std::map<uint, AudioOutputDevice*> devices = AudioOutputDeviceFactory::Devices();
+                for (std::map<uint, AudioOutputDevice*>::iterator iter = devices.begin(); iter != devices.end(); ++iter) {
+                    AudioOutputDevice* pOther = iter->second;
+                    if (!pOther->isAutonomousDevice() && pOther->MaxSamplesPerCycle() > samples)
+                        samples = pOther->MaxSamplesPerCycle();
+                }
+                return samples;
             }
 
             Mutex RegionInfoMutex; ///< protects the RegionInfo and SampleRefCount maps from concurrent access by the instrument loader and disk threads
@@ -178,6 +223,16 @@ namespace LinuxSampler {
             virtual void DeleteRegionIfNotUsed(R* pRegion, region_info_t* pRegInfo) = 0;
             virtual void DeleteSampleIfNotUsed(S* pSample, region_info_t* pRegInfo) = 0;
 
+            /**
+             * Whether the given sample shall be loaded completely into RAM
+             * by CacheInitialSamples(), instead of being streamed from disk.
+             * By default this applies to samples up to CONFIG_PRELOAD_SAMPLES
+             * sample points.
+             */
+            virtual bool IsSampleCachedCompletely(S* pSample) {
+                return pSample->GetTotalFrameCount() <= CONFIG_PRELOAD_SAMPLES;
+            }
+
             void SetKeyBindings(uint8_t* bindingsArray, int low, int high, int undefined = -1) {
                 if (low == undefined || high == undefined) return;
                 if (low < 0 || low > 127 || high < 0 || high > 127 || low > high) {
@@ -204,7 +259,7 @@ namespace LinuxSampler {
                 }
                 if (!pSample->GetTotalFrameCount()) return; // skip zero size samples
 
-                if (pSample->GetTotalFrameCount() <= CONFIG_PRELOAD_SAMPLES) {
+                if (IsSampleCachedCompletely(pSample)) {
                     // Sample is too short for disk streaming, so we load the whole
                     // sample into RAM and place 'pAudioIO->FragmentSize << CONFIG_MAX_PITCH'
                     // number of '0' samples (silence samples) behind the official buffer
@@ -26,6 +26,7 @@
 namespace LinuxSampler {
 
     InstrumentManagerThread::InstrumentManagerThread() : Thread(true, false, 0, -4) {
+        SetRole(ROLE_LOADER);
         eventHandler.pThread = this;
     }
 
@@ -60,6 +61,11 @@ namespace LinuxSampler {
 
         {
             LockGuard lock(mutex);
+            // a load still pending for the same engine channel would be
+            // replaced by this one anyway, so drop it instead of loading an
+            // instrument nobody is going to use (i.e. when the user quickly
+            // steps through a list of instruments)
+            RemoveLoadCommands(pEngineChannel);
             queue.push_back(cmd);
         }
 
@@ -155,17 +161,17 @@ namespace LinuxSampler {
         return 0;
     }
 
-    void InstrumentManagerThread::EventHandler::ChannelToBeRemoved(SamplerChannel* pChannel) {
-        /*
-           Removing from the queue an eventual scheduled loading of an instrument
-           to a sampler channel which is going to be removed.
-        */
-        LockGuard lock(pThread->mutex);
+    /**
+     * Removes all pending (not yet started) instrument loading commands for
+     * the given engine channel from the queue. The caller must hold
+     * @c mutex.
+     */
+    void InstrumentManagerThread::RemoveLoadCommands(EngineChannel* pEngineChannel) {
         std::list<command_t>::iterator it;
-        for (it = pThread->queue.begin(); it != pThread->queue.end();){
+        for (it = queue.begin(); it != queue.end();){
             if ((*it).type != command_t::DIRECT_LOAD) { ++it; continue; }
-            if ((*it).pEngineChannel == pChannel->GetEngineChannel()) {
-                it = pThread->queue.erase(it);
+            if ((*it).pEngineChannel == pEngineChannel) {
+                it = queue.erase(it);
                 // we don't break here because the same engine channel could
                 // occur more than once in the queue, so don't make optimizations
             } else {
@@ -174,6 +180,15 @@ namespace LinuxSampler {
         } 
     }
 
+    void InstrumentManagerThread::EventHandler::ChannelToBeRemoved(SamplerChannel* pChannel) {
+        /*
+           Removing from the queue an eventual scheduled loading of an instrument
+           to a sampler channel which is going to be removed.
+        */
+        LockGuard lock(pThread->mutex);
+        pThread->RemoveLoadCommands(pChannel->GetEngineChannel());
+    }
+
 #if defined(__APPLE__) && !defined(__x86_64__)
     int InstrumentManagerThread::StopThread() {
         // This is a fix for Mac OS X 32 bit, where SignalStopThread
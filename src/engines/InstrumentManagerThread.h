@@ -39,6 +39,17 @@ namespace LinuxSampler {
      * the InstrumentManager in the background, that is in a separate thread
      * without blocking the calling thread. This class is thus not exported
      * to the API.
+     *
+     * All tasks are processed one after another by a single thread on
+     * purpose: loading an instrument holds the mutex of the format's
+     * instrument ResourceManager for the whole time its samples are read
+     * (see ResourceManager::Borrow()), and all formats read their samples
+     * from the same disks. Several loader threads would therefore just
+     * wait on each other, while making the order in which the instruments
+     * of several channels become ready unpredictable. Loads that became
+     * obsolete before they were started are dropped instead (see
+     * RemoveLoadCommands()). Background jobs without such a lock, like
+     * the ones of the instruments DB, run on a WorkerPool instead.
      */
     class InstrumentManagerThread : public Thread {
         friend class EventHandler;
@@ -69,6 +80,7 @@ namespace LinuxSampler {
             Condition            conditionJobsLeft; ///< synchronizer to block this thread until a new job arrives
 
             int Main(); ///< Implementation of virtual method from class Thread.
+            void RemoveLoadCommands(EngineChannel* pEngineChannel);
         private:
             class EventHandler : public ChannelCountAdapter {
                 public:
@@ -32,6 +32,7 @@ namespace LinuxSampler {
         pLFO1 = new LFOUnsigned(1.0f);  // amplitude LFO (0..1 range)
         pLFO2 = new LFOUnsigned(1.0f);  // filter LFO (0..1 range)
         pLFO3 = new LFOSigned(1200.0f); // pitch LFO (-1200..+1200 range)
+        pSharedLFO1Levels = pSharedLFO2Levels = pSharedLFO3Levels = NULL;
         PlaybackState = playback_state_end;
         SynthesisMode = 0; // set all mode bits to 0 first
         // select synthesis implementation (asm core is not supported ATM)
@@ -116,6 +117,8 @@ namespace LinuxSampler {
         Delay           = itNoteOnEvent->FragmentPos();
         itTriggerEvent  = itNoteOnEvent;
         itKillEvent     = Pool<Event>::Iterator();
+        bReleased       = false;
+        bCulled         = false;
         MidiKeyBase* pKeyInfo = GetMidiKeyInfo(MIDIKey());
 
         pGroupEvents = iKeyGroup ? pEngineChannel->ActiveKeyGroups[iKeyGroup] : 0;
@@ -251,6 +254,12 @@ namespace LinuxSampler {
     #endif
 #endif
 
+#ifdef CONFIG_INTERPOLATE_PITCH
+        // the pitch ramp starts at the pitch of the first subfragment
+        fLastPitch = 0;
+        finalSynthesisParameters.fFinalPitchDelta = 0;
+#endif
+
         if (pSignalUnitRack == NULL) {
             // setup EG 2 (VCF Cutoff EG)
             {
@@ -358,6 +367,8 @@ namespace LinuxSampler {
      */
     void AbstractVoice::Synthesize(uint Samples, sample_t* pSrc, uint Skip) {
         bool delay = false; // Whether the voice playback should be delayed for this call
+
+        PrepareSharedLFOs(Samples);
         
         if (pSignalUnitRack != NULL) {
             uint delaySteps = pSignalUnitRack->GetEndpointUnit()->DelayTrigger();
@@ -373,6 +384,10 @@ namespace LinuxSampler {
             }
         }
         
+        // without source the voice is waiting for its disk stream, which
+        // delays its playback as well (see VoiceBase::Render())
+        if (!pSrc) delay = true;
+
         AbstractEngineChannel* pChannel = pEngineChannel;
         MidiKeyBase* pMidiKeyInfo = GetMidiKeyInfo(MIDIKey());
 
@@ -440,6 +455,12 @@ namespace LinuxSampler {
             }
         }
 
+        // volume coefficient below which this voice is inaudible (the
+        // coefficients include the conversion from the sample's integer range)
+        const float fCullThreshold = GLOBAL_VOICE_CULL_THRESHOLD /
+            (SmplInfo.BitDepth == 16 ? 32768.0f : 32768.0f * 65536.0f);
+        bool bSkipped = false;
+
         uint i = Skip;
         while (i < Samples) {
             int iSubFragmentEnd = RTMath::Min(i + CONFIG_DEFAULT_SUBFRAGMENT_SIZE, Samples);
@@ -466,7 +487,8 @@ namespace LinuxSampler {
             // process transition events (note on, note off & sustain pedal)
             processTransitionEvents(itNoteEvent, iSubFragmentEnd);
             processGroupEvents(itGroupEvent, iSubFragmentEnd);
-            
+
+            float fEnvelopeVolume; // volume without LFO modulation
             if (pSignalUnitRack == NULL) {
                 // if the voice was killed in this subfragment, or if the
                 // filter EG is finished, switch EG1 to fade out stage
@@ -506,12 +528,15 @@ namespace LinuxSampler {
                         fFinalCutoff *= pEG2->processPow();
                         break;
                 }
+                fEnvelopeVolume = fFinalVolume;
                 if (EG3.active()) finalSynthesisParameters.fFinalPitch *= EG3.render();
 
                 // process low frequency oscillators
-                if (bLFO1Enabled) fFinalVolume *= (1.0f - pLFO1->render());
-                if (bLFO2Enabled) fFinalCutoff *= (1.0f - pLFO2->render());
-                if (bLFO3Enabled) finalSynthesisParameters.fFinalPitch *= RTMath::CentsToFreqRatio(pLFO3->render());
+                // (shared ones were already rendered for the whole fragment)
+                const uint iSubFragment = i / CONFIG_DEFAULT_SUBFRAGMENT_SIZE;
+                if (bLFO1Enabled) fFinalVolume *= (1.0f - (pSharedLFO1Levels ? pSharedLFO1Levels[iSubFragment] : pLFO1->render()));
+                if (bLFO2Enabled) fFinalCutoff *= (1.0f - (pSharedLFO2Levels ? pSharedLFO2Levels[iSubFragment] : pLFO2->render()));
+                if (bLFO3Enabled) finalSynthesisParameters.fFinalPitch *= RTMath::CentsToFreqRatio(pSharedLFO3Levels ? pSharedLFO3Levels[iSubFragment] : pLFO3->render());
             } else {
                 // if the voice was killed in this subfragment, enter fade out stage
                 if (itKillEvent && killPos <= iSubFragmentEnd) {
@@ -527,6 +552,7 @@ namespace LinuxSampler {
                 }*/
                 // TODO: ^^^
 
+                fEnvelopeVolume = fFinalVolume * pSignalUnitRack->GetEndpointUnit()->GetEnvelopeVolume();
                 fFinalVolume   *= pSignalUnitRack->GetEndpointUnit()->GetVolume();
                 fFinalCutoff    = pSignalUnitRack->GetEndpointUnit()->CalculateFilterCutoff(fFinalCutoff);
                 fFinalResonance = pSignalUnitRack->GetEndpointUnit()->CalculateResonance(fFinalResonance);
@@ -542,6 +568,25 @@ namespace LinuxSampler {
             // limit the pitch so we don't read outside the buffer
             finalSynthesisParameters.fFinalPitch = RTMath::Min(finalSynthesisParameters.fFinalPitch, float(1 << CONFIG_MAX_PITCH));
 
+#ifdef CONFIG_INTERPOLATE_PITCH
+            // ramp the pitch from the end of the previous subfragment to
+            // the new value, instead of changing it abruptly
+            const float fTargetPitch = finalSynthesisParameters.fFinalPitch;
+            if (fLastPitch == 0) fLastPitch = fTargetPitch;
+            finalSynthesisParameters.fFinalPitch      = fLastPitch;
+            finalSynthesisParameters.fFinalPitchDelta = (fTargetPitch - fLastPitch) / (iSubFragmentEnd - i);
+            fLastPitch = fTargetPitch;
+            // the synthesis functions advance the pitch on every sample
+            // point, so sum up the pitch of each point of the ramp (the
+            // first one being played at the start pitch)
+            const uint uiRampLen = iSubFragmentEnd - i;
+            const double dPosIncrement =
+                uiRampLen * double(finalSynthesisParameters.fFinalPitch) +
+                0.5 * double(finalSynthesisParameters.fFinalPitchDelta) * uiRampLen * (uiRampLen - 1);
+#else
+            const double dPosIncrement = (iSubFragmentEnd - i) * finalSynthesisParameters.fFinalPitch;
+#endif
+
             // if filter enabled then update filter coefficients
             if (SYNTHESIS_MODE_GET_FILTER(SynthesisMode)) {
                 finalSynthesisParameters.filterLeft.SetParameters(fFinalCutoff, fFinalResonance, GetEngine()->SampleRate);
@@ -551,12 +596,17 @@ namespace LinuxSampler {
             // do we need resampling?
             const float __PLUS_ONE_CENT  = 1.000577789506554859250142541782224725466f;
             const float __MINUS_ONE_CENT = 0.9994225441413807496009516495583113737666f;
-            const bool bResamplingRequired = !(finalSynthesisParameters.fFinalPitch <= __PLUS_ONE_CENT &&
-                                               finalSynthesisParameters.fFinalPitch >= __MINUS_ONE_CENT);
+            bool bResamplingRequired = !(finalSynthesisParameters.fFinalPitch <= __PLUS_ONE_CENT &&
+                                         finalSynthesisParameters.fFinalPitch >= __MINUS_ONE_CENT);
+#ifdef CONFIG_INTERPOLATE_PITCH
+            if (finalSynthesisParameters.fFinalPitchDelta != 0.0f) bResamplingRequired = true;
+#endif
             SYNTHESIS_MODE_SET_INTERPOLATE(SynthesisMode, bResamplingRequired);
 
             // prepare final synthesis parameters structure
             finalSynthesisParameters.uiToGo            = iSubFragmentEnd - i;
+            // full subfragments are rendered by the fixed size synthesis loops
+            SYNTHESIS_MODE_SET_FIXEDSIZE(SynthesisMode, finalSynthesisParameters.uiToGo == CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
 #ifdef CONFIG_INTERPOLATE_VOLUME
             finalSynthesisParameters.fFinalVolumeDeltaLeft  =
                 (fFinalVolume * VolumeLeft  * PanLeftSmoother.render() -
@@ -570,8 +620,37 @@ namespace LinuxSampler {
             finalSynthesisParameters.fFinalVolumeRight =
                 fFinalVolume * VolumeRight * PanRightSmoother.render();
 #endif
+            // if the voice is inaudible in this subfragment, just advance its
+            // playback position instead of rendering it
+#ifdef CONFIG_INTERPOLATE_VOLUME
+            const float fPeakVolume = RTMath::Max(
+                RTMath::Max(fabs(finalSynthesisParameters.fFinalVolumeLeft), fabs(finalSynthesisParameters.fFinalVolumeRight)),
+                RTMath::Max(fabs(finalSynthesisParameters.fFinalVolumeLeft  + finalSynthesisParameters.fFinalVolumeDeltaLeft  * finalSynthesisParameters.uiToGo),
+                            fabs(finalSynthesisParameters.fFinalVolumeRight + finalSynthesisParameters.fFinalVolumeDeltaRight * finalSynthesisParameters.uiToGo))
+            );
+#else
+            const float fPeakVolume = RTMath::Max(fabs(finalSynthesisParameters.fFinalVolumeLeft), fabs(finalSynthesisParameters.fFinalVolumeRight));
+#endif
+            const bool bInaudible = fPeakVolume < fCullThreshold;
+            if (bInaudible) {
+                bSkipped = true;
+                // a released voice won't become audible anymore, so free it
+                // (ignoring LFO modulation, which might just be at its minimum)
+                if (bReleased && !bCulled &&
+                    fEnvelopeVolume * RTMath::Max(VolumeLeft, VolumeRight) < fCullThreshold)
+                {
+                    if (pSignalUnitRack == NULL) pEG1->enterFadeOutStage();
+                    else pSignalUnitRack->EnterFadeOutStage();
+                    atomic_inc(&GetEngine()->CulledVoiceCount);
+                    bCulled = true;
+                }
+            }
+
             // render audio for one subfragment
-            if (!delay) RunSynthesisFunction(SynthesisMode, &finalSynthesisParameters, &loop);
+            if (!delay) {
+                if (bInaudible) RunAdvanceFunction(SynthesisMode, &finalSynthesisParameters, &loop);
+                else RunSynthesisFunction(SynthesisMode, &finalSynthesisParameters, &loop);
+            }
 
             if (pSignalUnitRack == NULL) {
                 // stop the rendering if volume EG is finished
@@ -581,7 +660,7 @@ namespace LinuxSampler {
                 if (!pSignalUnitRack->GetEndpointUnit()->Active()) break;
             }
 
-            const double newPos = Pos + (iSubFragmentEnd - i) * finalSynthesisParameters.fFinalPitch;
+            const double newPos = Pos + dPosIncrement;
 
             if (pSignalUnitRack == NULL) {
                 // increment envelopes' positions
@@ -615,6 +694,8 @@ namespace LinuxSampler {
             i = iSubFragmentEnd;
         }
         
+        if (bSkipped) GetEngine()->InaudibleVoiceCountTemp++;
+
         if (delay) return;
 
         if (bVoiceRequiresDedicatedRouting) {
@@ -715,6 +796,7 @@ namespace LinuxSampler {
                 if (itEvent->Type == Event::type_release_key) {
                     EnterReleaseStage();
                 } else if (itEvent->Type == Event::type_cancel_release_key) {
+                    bReleased = false;
                     if (pSignalUnitRack == NULL) {
                         pEG1->update(EG::event_cancel_release, GetEngine()->SampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
                         pEG2->update(EG::event_cancel_release, GetEngine()->SampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
@@ -861,6 +943,7 @@ namespace LinuxSampler {
     }
 
     void AbstractVoice::EnterReleaseStage() {
+        bReleased = true;
         if (pSignalUnitRack == NULL) {
             pEG1->update(EG::event_release, GetEngine()->SampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
             pEG2->update(EG::event_release, GetEngine()->SampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
@@ -107,6 +107,16 @@ namespace LinuxSampler {
             virtual void VoiceFreed() { }
 
             virtual void Synthesize(uint Samples, sample_t* pSrc, uint Skip);
+
+            /**
+             * Called at the beginning of each audio fragment the voice is
+             * rendered in. Descendants with LFOs shared by several voices
+             * set pSharedLFO1Levels, pSharedLFO2Levels and pSharedLFO3Levels
+             * here.
+             *
+             * @param Samples - amount of sample points of this fragment
+             */
+            virtual void PrepareSharedLFOs(uint Samples) { }
             
             uint GetSampleRate() { return GetEngine()->SampleRate; }
             
@@ -173,14 +183,22 @@ namespace LinuxSampler {
             bool                        bLFO1Enabled;        ///< Should we use the Amplitude LFO for this voice?
             bool                        bLFO2Enabled;        ///< Should we use the Filter Cutoff LFO for this voice?
             bool                        bLFO3Enabled;        ///< Should we use the Pitch LFO for this voice?
+            const float*                pSharedLFO1Levels;   ///< Levels of LFO 1 per subfragment of the current fragment if it is shared with other voices (see SharedLFOBank), NULL if pLFO1 is used.
+            const float*                pSharedLFO2Levels;   ///< Levels of LFO 2 per subfragment of the current fragment if it is shared with other voices (see SharedLFOBank), NULL if pLFO2 is used.
+            const float*                pSharedLFO3Levels;   ///< Levels of LFO 3 per subfragment of the current fragment if it is shared with other voices (see SharedLFOBank), NULL if pLFO3 is used.
             Pool<Event>::Iterator       itTriggerEvent;      ///< First event on the key's list the voice should process (only needed for the first audio fragment in which voice was triggered, after that it will be set to NULL).
             Pool<Event>::Iterator       itKillEvent;         ///< Event which caused this voice to be killed
             int                         SynthesisMode;
             float                       fFinalCutoff;
             float                       fFinalResonance;
             gig::SynthesisParam         finalSynthesisParameters;
+#ifdef CONFIG_INTERPOLATE_PITCH
+            float                       fLastPitch;          ///< Pitch at the end of the previous subfragment (0 before the first subfragment).
+#endif
             gig::Loop                   loop;
             RTList<Event>*              pGroupEvents;        ///< Events directed to an exclusive group
+            bool                        bReleased;           ///< Whether the voice is in its release stage, so its volume will only decrease from now on.
+            bool                        bCulled;             ///< Whether the voice is being faded out early, because it became inaudible in its release stage.
             
             EqSupport* pEq;         ///< Used for per voice equalization
             bool       bEqSupport;
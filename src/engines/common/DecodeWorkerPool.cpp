@@ -0,0 +1,134 @@
+/***************************************************************************
+ *                                                                         *
+ *   LinuxSampler - modular, streaming capable sampler                     *
+ *                                                                         *
+ *   Copyright (C) 2026 The LinuxSampler Developers                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston,                 *
+ *   MA  02111-1307  USA                                                   *
+ ***************************************************************************/
+
+#include "DecodeWorkerPool.h"
+
+#include <stdlib.h>
+#if !defined(WIN32)
+# include <pthread.h>
+#endif
+
+namespace LinuxSampler {
+
+DecodeWorkerPool::Worker::Worker(DecodeWorkerPool* pPool) :
+    Thread(true, false, 1, -2), pPool(pPool)
+{
+    SetRole(ROLE_DISK);
+}
+
+int DecodeWorkerPool::Worker::Main() {
+    while (true) {
+        #if !defined(WIN32)
+        pthread_testcancel(); // mandatory for OSX
+        #endif
+        // sleep until the disk thread hands over new jobs
+        pPool->jobsAvailable.WaitIf(false);
+        pPool->jobsAvailable.Unlock();
+        if (pPool->bStop) return 0;
+        pPool->ProcessJobs();
+    }
+    return EXIT_FAILURE;
+}
+
+DecodeWorkerPool::DecodeWorkerPool(int Workers) :
+    nextJob(0), jobCount(0), pendingJobs(0), bStarted(false), bStop(false),
+    jobsAvailable(false), jobsDone(true), oldCancelState(0)
+{
+    for (int i = 0; i < Workers; ++i)
+        workers.push_back(new Worker(this));
+}
+
+DecodeWorkerPool::~DecodeWorkerPool() {
+    bStop = true;
+    jobsAvailable.Set(true); // wake up all workers, so they quit
+    for (uint i = 0; i < workers.size(); ++i) {
+        workers[i]->StopThread();
+        delete workers[i];
+    }
+}
+
+void DecodeWorkerPool::Add(Stream* pStream, unsigned long SampleCount) {
+    job_t job = { pStream, SampleCount, 0 };
+    jobs.push_back(job);
+}
+
+void DecodeWorkerPool::Start() {
+    if (jobs.empty()) return;
+    if (!bStarted) {
+        for (uint i = 0; i < workers.size(); ++i)
+            workers[i]->StartThread();
+        bStarted = true;
+    }
+    #if !defined(WIN32)
+    // the calling (disk) thread must not be cancelled before Finish(), since
+    // the workers are still accessing the streams and this pool meanwhile
+    pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &oldCancelState);
+    #endif
+    {
+        LockGuard lock(mutex);
+        nextJob     = 0;
+        jobCount    = jobs.size();
+        pendingJobs = jobs.size();
+    }
+    jobsDone.Set(false);
+    jobsAvailable.Set(true);
+}
+
+int DecodeWorkerPool::Finish() {
+    if (jobs.empty()) return 0;
+    ProcessJobs(); // rather help than just wait
+    jobsDone.WaitIf(false);
+    jobsDone.Unlock();
+    int result = 0;
+    for (uint i = 0; i < jobs.size(); ++i)
+        if (jobs[i].Result > result) result = jobs[i].Result;
+    {
+        LockGuard lock(mutex);
+        jobCount = 0;
+    }
+    jobs.clear();
+    #if !defined(WIN32)
+    pthread_setcancelstate(oldCancelState, NULL);
+    #endif
+    return result;
+}
+
+/**
+ * Processes jobs until none is left to be processed. Called by the worker
+ * threads and by the disk thread.
+ */
+void DecodeWorkerPool::ProcessJobs() {
+    while (true) {
+        job_t* pJob;
+        {
+            LockGuard lock(mutex);
+            if (nextJob >= jobCount) return;
+            pJob = &jobs[nextJob++];
+            if (nextJob == jobCount) jobsAvailable.Set(false);
+        }
+        pJob->Result = pJob->pStream->ReadAhead(pJob->SampleCount);
+        LockGuard lock(mutex);
+        if (--pendingJobs == 0) jobsDone.Set(true);
+    }
+}
+
+} // namespace LinuxSampler
@@ -0,0 +1,109 @@
+/***************************************************************************
+ *                                                                         *
+ *   LinuxSampler - modular, streaming capable sampler                     *
+ *                                                                         *
+ *   Copyright (C) 2026 The LinuxSampler Developers                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston,                 *
+ *   MA  02111-1307  USA                                                   *
+ ***************************************************************************/
+
+#ifndef LS_DECODEWORKERPOOL_H
+#define LS_DECODEWORKERPOOL_H
+
+#include <vector>
+
+#include "Stream.h"
+#include "../../common/Thread.h"
+#include "../../common/Condition.h"
+#include "../../common/Mutex.h"
+
+namespace LinuxSampler {
+
+/**
+ * Worker threads of a disk thread, which refill streams of compressed
+ * samples (see Stream::IsCompressed()) in parallel. Decoding e.g. FLAC is
+ * CPU bound, so a single disk thread could only keep a fraction of the
+ * streams filled it could keep filled with uncompressed samples.
+ *
+ * The disk thread adds the refill jobs of one cycle with Add(), then calls
+ * Start(), refills the uncompressed streams by itself meanwhile and
+ * finally calls Finish(), which helps with the remaining jobs and returns
+ * when all of them are done. So the workers never touch a stream while the
+ * disk thread launches or kills it.
+ *
+ * The worker threads are only started when the first job arrives.
+ *
+ * @e Note: this class is not exported to the C++ API of the sampler!
+ */
+class DecodeWorkerPool {
+public:
+    DecodeWorkerPool(int Workers);
+    ~DecodeWorkerPool();
+
+    /**
+     * Adds a job for refilling the given stream by @a SampleCount sample
+     * points (see Stream::ReadAhead()). Must not be called between Start()
+     * and Finish().
+     */
+    void Add(Stream* pStream, unsigned long SampleCount);
+
+    /**
+     * Lets the worker threads process the jobs added with Add(). The
+     * calling thread cannot be cancelled until Finish() returned.
+     */
+    void Start();
+
+    /**
+     * Waits until all jobs are done and removes them.
+     *
+     * @returns the highest amount of sample points one job refilled
+     */
+    int Finish();
+
+private:
+    class Worker : public Thread {
+    public:
+        Worker(DecodeWorkerPool* pPool);
+    protected:
+        int Main() OVERRIDE;
+    private:
+        DecodeWorkerPool* pPool;
+    };
+
+    struct job_t {
+        Stream*       pStream;
+        unsigned long SampleCount;
+        int           Result; ///< Return value of Stream::ReadAhead().
+    };
+
+    std::vector<Worker*> workers;
+    std::vector<job_t>   jobs;
+    uint                 nextJob;      ///< Index of the next job not yet being processed (protected by @c mutex).
+    uint                 jobCount;     ///< Amount of jobs handed over by Start(), 0 outside of Start() and Finish() (protected by @c mutex).
+    uint                 pendingJobs;  ///< Amount of jobs not finished yet (protected by @c mutex).
+    bool                 bStarted;     ///< Whether the worker threads were started already.
+    bool                 bStop;        ///< Tells the worker threads to quit.
+    Mutex                mutex;
+    Condition            jobsAvailable; ///< Whether there are jobs not yet being processed.
+    Condition            jobsDone;      ///< Whether all jobs are finished.
+    int                  oldCancelState; ///< Cancel state of the disk thread before Start().
+
+    void ProcessJobs();
+};
+
+} // namespace LinuxSampler
+
+#endif // LS_DECODEWORKERPOOL_H
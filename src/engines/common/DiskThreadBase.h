@@ -27,8 +27,10 @@
 #define __LS_DISKTHREADBASE_H__
 
 #include <map>
+#include <vector>
 
 #include "StreamBase.h"
+#include "DecodeWorkerPool.h"
 #include "../EngineChannel.h"
 #include "../InstrumentManagerBase.h"
 
@@ -37,6 +39,20 @@
 #include "../../common/Thread.h"
 #include "../../common/RingBuffer.h"
 #include "../../common/atomic.h"
+#include "../../common/HugePageAllocator.h"
+#include "../../common/Exception.h"
+
+// Ring buffer size (in sample words) of streams of compressed samples, if
+// they are refilled by decode worker threads. Decoding takes much more CPU
+// time than reading, so those streams decode further ahead than the others
+// (as long as the stream arena has room for it, see AssignStreamBuffer()).
+#define DECODE_AHEAD_BUFFER_SIZE    (2 * CONFIG_STREAM_BUFFER_SIZE)
+
+// Refill size limit for streams of compressed samples. The decode workers
+// fill all free space of a stream's buffer in one job instead of at most
+// CONFIG_STREAM_MAX_REFILL_SIZE sample points, to keep the per job overhead
+// low.
+#define DECODE_AHEAD_REFILL_SIZE    DECODE_AHEAD_BUFFER_SIZE
 
 namespace LinuxSampler {
 
@@ -81,11 +97,19 @@ namespace LinuxSampler {
             RingBuffer<delete_command_t,false>* GhostQueue;                         ///< Contains handles to streams that are not used anymore and weren't deletable immediately
             RingBuffer<Stream::Handle,false>    DeletionNotificationQueue;          ///< In case the original sender requested a notification for its stream deletion order, this queue will receive the handle of the respective stream once actually be deleted by the disk thread.
             RingBuffer<R*,false>*               DeleteRegionQueue;          ///< Contains dimension regions that are not used anymore and should be handed back to the instrument resource manager
+            RingBuffer<R*,false>*               CacheRegionQueue;           ///< Contains regions whose samples should be cached by the instrument resource manager (see CONFIG_LAZY_SAMPLE_LOADING)
             RingBuffer<program_change_command_t,false> ProgramChangeQueue;          ///< Contains requests for MIDI program change
             unsigned int                   RefillStreamsPerRun;                    ///< How many streams should be refilled in each loop run
             Stream**                       pStreams; ///< Contains all disk streams (whether used or unused)
             Stream**                       pCreatedStreams; ///< This is where the voice (audio thread) picks up it's meanwhile hopefully created disk stream.
             static Stream*                 SLOT_RESERVED;                          ///< This value is used to mark an entry in pCreatedStreams[] as reserved.
+            uint8_t*                       pStreamArena;     ///< One memory block shared by the ring buffers of all disk streams.
+            size_t                         StreamArenaSize;  ///< Size of @c pStreamArena in bytes.
+            bool                           bStreamArenaLocked; ///< Whether @c pStreamArena could be locked in physical RAM.
+            size_t                         StreamSlotSize;   ///< Size in bytes of each slot of @c pStreamArena (see AssignStreamBuffer()).
+            std::vector<bool>              StreamSlotUsed;   ///< Whether the respective slot of @c pStreamArena is assigned to a stream.
+            uint                           StreamWrapElements; ///< Wrap space of the streams' ring buffers in sample words.
+            DecodeWorkerPool*              pDecodeWorkers;   ///< Refills streams of compressed samples concurrently, NULL if disabled.
 
             // Methods
 
@@ -104,6 +128,12 @@ namespace LinuxSampler {
                     return;
                 }
                 LaunchStream(newstream, Command.hStream, Command.pStreamRef, Command.pRegion, Command.SampleOffset, Command.DoLoop);
+                if (!AssignStreamBuffer(newstream)) {
+                    std::cerr << "DiskThread: No stream buffer memory left (OrderID:" << Command.OrderID;
+                    std::cerr << ") - report if this happens, this is a bug!\n" << std::flush;
+                    newstream->Kill();
+                    return;
+                }
                 dmsg(4,("new Stream launched by disk thread (OrderID:%d,StreamHandle:%d)\n", Command.OrderID, Command.hStream));
                 if (pCreatedStreams[Command.OrderID] != SLOT_RESERVED) {
                     std::cerr << "DiskThread: Slot " << Command.OrderID << " already occupied! Please report this!\n" << std::flush;
@@ -144,32 +174,64 @@ namespace LinuxSampler {
                 }
             }
 
+            /**
+             * Returns the amount of sample points to be read for refilling
+             * the given stream, at most @a MaxRefillSize sample points.
+             */
+            int RefillAmount(Stream* pStream, int MaxRefillSize) {
+                int writespace = pStream->GetWriteSpaceToEnd();
+                if (writespace == 0) return 0;
+
+                int capped_writespace = writespace;
+                // if there is too much buffer space available then cut the read/write
+                // size to MaxRefillSize which is by default 65536 samples = 256KBytes
+                if (writespace > MaxRefillSize) capped_writespace = MaxRefillSize;
+
+                // adjust the amount to read in order to ensure that the buffer wraps correctly
+                return pStream->AdjustWriteSpaceToAvoidBoundary(writespace, capped_writespace);
+            }
+
             void RefillStreams() {
                 // sort the streams by most empty stream
                 qsort(pStreams, Streams, sizeof(Stream*), CompareStreamWriteSpace);
 
+                // let the decode workers refill the most empty streams of
+                // compressed samples, while we're refilling the others
+                if (pDecodeWorkers) {
+                    const uint maxJobs = RefillStreamsPerRun * (CONFIG_DECODE_THREADS + 1);
+                    for (uint i = 0, n = 0; i < Streams && n < maxJobs; i++) {
+                        if (pStreams[i]->GetState() != Stream::state_active ||
+                            !pStreams[i]->IsCompressed()) continue;
+                        int read_amount = RefillAmount(pStreams[i], DECODE_AHEAD_REFILL_SIZE);
+                        if (read_amount == 0) break;
+                        pDecodeWorkers->Add(pStreams[i], read_amount);
+                        n++;
+                    }
+                    pDecodeWorkers->Start();
+                }
+
                 // refill the most empty streams
-                for (uint i = 0; i < RefillStreamsPerRun; i++) {
+                for (uint i = 0, n = 0; i < Streams && n < RefillStreamsPerRun; i++) {
+                    if (pDecodeWorkers && pStreams[i]->GetState() == Stream::state_active &&
+                        pStreams[i]->IsCompressed()) continue; // already handed over to the decode workers
+                    n++;
                     if (pStreams[i]->GetState() == Stream::state_active) {
 
                         //float filledpercentage = (float) pStreams[i]->GetReadSpace() / 131072.0 * 100.0;
                         //dmsg(("\nbuffer fill: %.1f%\n", filledpercentage));
 
-                        int writespace = pStreams[i]->GetWriteSpaceToEnd();
-                        if (writespace == 0) break;
+                        int read_amount = RefillAmount(pStreams[i], CONFIG_STREAM_MAX_REFILL_SIZE);
+                        if (read_amount == 0) break;
 
-                        int capped_writespace = writespace;
-                        // if there is too much buffer space available then cut the read/write
-                        // size to CONFIG_STREAM_MAX_REFILL_SIZE which is by default 65536 samples = 256KBytes
-                        if (writespace > CONFIG_STREAM_MAX_REFILL_SIZE) capped_writespace = CONFIG_STREAM_MAX_REFILL_SIZE;
-
-                        // adjust the amount to read in order to ensure that the buffer wraps correctly
-                        int read_amount = pStreams[i]->AdjustWriteSpaceToAvoidBoundary(writespace, capped_writespace);
                         // if we wasn't able to refill one of the stream buffers by more than
                         // CONFIG_STREAM_MIN_REFILL_SIZE we'll send the disk thread to sleep later
                         if (pStreams[i]->ReadAhead(read_amount) > CONFIG_STREAM_MIN_REFILL_SIZE) this->IsIdle = false;
                     }
                 }
+
+                if (pDecodeWorkers) {
+                    if (pDecodeWorkers->Finish() > CONFIG_STREAM_MIN_REFILL_SIZE) this->IsIdle = false;
+                }
             }
 
             Stream::Handle CreateHandle() {
@@ -205,25 +267,41 @@ namespace LinuxSampler {
                 DeletionQueue       = new RingBuffer<delete_command_t,false>(4*MaxStreams);
                 GhostQueue          = new RingBuffer<delete_command_t,false>(MaxStreams);
                 DeleteRegionQueue   = new RingBuffer<R*,false>(4*MaxStreams);
+                CacheRegionQueue    = new RingBuffer<R*,false>(4*MaxStreams);
                 pStreams            = new Stream*[MaxStreams];
                 pCreatedStreams     = new Stream*[MaxStreams + 1];
                 Streams             = MaxStreams;
                 RefillStreamsPerRun = CONFIG_REFILL_STREAMS_PER_RUN;
 
+                SetRole(ROLE_DISK);
+
                 for (int i = 1; i <= MaxStreams; i++) {
                     pCreatedStreams[i] = NULL;
                 }
                 ActiveStreamCountMax = 0;
+                pStreamArena         = NULL;
+                StreamArenaSize      = 0;
+                bStreamArenaLocked   = false;
+                StreamSlotSize       = 0;
+                StreamWrapElements   = 0;
+                pDecodeWorkers       = (CONFIG_DECODE_THREADS > 0) ?
+                    new DecodeWorkerPool(CONFIG_DECODE_THREADS) : NULL;
             }
 
             virtual ~DiskThreadBase() {
+                if (pDecodeWorkers) delete pDecodeWorkers;
                 for (int i = 0; i < Streams; i++) {
                     if (pStreams[i]) delete pStreams[i];
                 }
+                if (pStreamArena) {
+                    if (bStreamArenaLocked) unlockMemory(pStreamArena, StreamArenaSize);
+                    HugePageAllocator::Free(pStreamArena, StreamArenaSize);
+                }
                 if (CreationQueue) delete CreationQueue;
                 if (DeletionQueue) delete DeletionQueue;
                 if (GhostQueue)    delete GhostQueue;
                 if (DeleteRegionQueue) delete DeleteRegionQueue;
+                if (CacheRegionQueue) delete CacheRegionQueue;
                 if (pStreams)        delete[] pStreams;
                 if (pCreatedStreams) delete[] pCreatedStreams;
             }
@@ -381,6 +459,23 @@ namespace LinuxSampler {
                 return 0;
             }
 
+            /**
+             * Tell the disk thread to cache the sample of the given region,
+             * which couldn't be played because its sample wasn't cached yet
+             * (see CONFIG_LAZY_SAMPLE_LOADING). The disk thread will let the
+             * instrument resource manager cache it. (OrderCachingOfRegion is
+             * called from the audio thread when a voice is triggered.)
+             */
+            int OrderCachingOfRegion(R* pReg) {
+                dmsg(4,("Disk Thread: region caching ordered\n"));
+                if (CacheRegionQueue->write_space() < 1) {
+                    dmsg(1,("DiskThread: CacheRegion queue full!\n"));
+                    return -1;
+                }
+                CacheRegionQueue->push(&pReg);
+                return 0;
+            }
+
             /**
              * Tell the disk thread to do a program change on the specified
              * EngineChannel.
@@ -505,6 +600,19 @@ namespace LinuxSampler {
                         pInstruments->HandBackRegion(pRgn);
                     }
 
+                    // cache the samples of regions triggered for the first
+                    // time (only one per iteration, since this might take
+                    // a while and the streams have to be refilled as well)
+                    if (CacheRegionQueue->read_space() > 0) {
+                        R* pRgn;
+                        CacheRegionQueue->pop(&pRgn);
+                        pInstruments->CacheRegion(pRgn);
+                        this->IsIdle = false;
+                    } else if (pInstruments->CacheNextScheduledSample()) {
+                        // related samples CacheRegion() left for later
+                        this->IsIdle = false;
+                    }
+
                     // perform MIDI program change commands
                     if (ProgramChangeQueue.read_space() > 0) {
                         program_change_command_t cmd;
@@ -541,14 +649,121 @@ namespace LinuxSampler {
                 return EXIT_FAILURE;
             }
 
-            virtual Stream* CreateStream(long BufferSize, uint BufferWrapElements) = 0;
+            virtual Stream* CreateStream(long BufferSize, uint BufferWrapElements, uint8_t* pBufferMemory) = 0;
 
+            /**
+             * Creates all disk streams and one shared memory block for their
+             * ring buffers (preferably on huge pages), which is locked in
+             * physical RAM as a whole (if possible), instead of allocating
+             * each ring buffer separately.
+             *
+             * Streams are reused for arbitrary samples, so their ring buffers
+             * are only assigned when a stream is launched, sized for the
+             * stream's sample by AssignStreamBuffer(). For this the memory
+             * block is divided into one slot per stream, each large enough
+             * for CONFIG_STREAM_BUFFER_SIZE 16 bit sample words. Each slot
+             * starts on a cache line boundary, so no two streams share a
+             * cache line.
+             */
             void CreateAllStreams(int MaxStreams, uint BufferWrapElements) {
+                StreamWrapElements = BufferWrapElements;
+                StreamSlotSize = CacheLineAligned(
+                    StreamBufferBytes(2, 3 * BufferWrapElements) + 3 * BufferWrapElements
+                );
+                StreamArenaSize = StreamSlotSize * MaxStreams;
+                pStreamArena = (uint8_t*) HugePageAllocator::Allocate(StreamArenaSize);
+                if (!pStreamArena) throw Exception("DiskThread: could not allocate stream buffers");
+                bStreamArenaLocked = lockMemory(pStreamArena, StreamArenaSize);
+                if (!bStreamArenaLocked) {
+                    dmsg(2,("DiskThread: could not lock %lu bytes of stream buffer memory\n", (unsigned long) StreamArenaSize));
+                }
+                StreamSlotUsed.assign(MaxStreams, false);
                 for (int i = 0; i < MaxStreams; i++) {
-                    pStreams[i] = CreateStream(CONFIG_STREAM_BUFFER_SIZE, BufferWrapElements);
+                    pStreams[i] = CreateStream(CONFIG_STREAM_BUFFER_SIZE, BufferWrapElements, NULL);
                 }
             }
 
+            static size_t CacheLineAligned(size_t Bytes) {
+                return (Bytes + RINGBUFFER_CACHE_LINE_SIZE - 1) & ~size_t(RINGBUFFER_CACHE_LINE_SIZE - 1);
+            }
+
+            /**
+             * Returns the ring buffer size in bytes (a power of two) for a
+             * stream of @a BytesPerSample bytes per sample word, that is
+             * the smallest one holding @a SampleWords sample words and more
+             * than the wrap space of @a WrapBytes bytes.
+             */
+            static uint StreamBufferBytes(uint BytesPerSample, uint WrapBytes, uint SampleWords = CONFIG_STREAM_BUFFER_SIZE) {
+                uint bytes = 1;
+                while (bytes < SampleWords * BytesPerSample || bytes <= WrapBytes)
+                    bytes <<= 1;
+                return bytes;
+            }
+
+            /**
+             * Assigns ring buffer memory from the stream arena to the given,
+             * just launched stream, sized for its sample: a 16 bit stream
+             * takes one slot of the arena, a 24 bit stream two adjacent
+             * slots. Streams of compressed samples, which are decoded by the
+             * decode workers, get DECODE_AHEAD_BUFFER_SIZE sample words
+             * instead. If that would not leave one free slot for each other
+             * stream without a buffer, the stream gets a smaller buffer
+             * (down to one slot) instead, so that launching a stream never
+             * runs out of memory.
+             *
+             * Streams which reached their end are reset to unused by the
+             * audio thread, so the disk thread reclaims the slots of unused
+             * streams only here, when it needs them.
+             */
+            bool AssignStreamBuffer(Stream* pStream) {
+                uint streamsWithoutBuffer = 0;
+                for (uint i = 0; i < Streams; i++) {
+                    Stream* pOther = pStreams[i];
+                    if (pOther->pBufferMemory &&
+                        (pOther == pStream || pOther->GetState() == Stream::state_unused))
+                        ReleaseStreamBuffer(pOther);
+                    if (!pOther->pBufferMemory && pOther != pStream) streamsWithoutBuffer++;
+                }
+                uint freeSlots = 0;
+                for (uint i = 0; i < StreamSlotUsed.size(); i++)
+                    if (!StreamSlotUsed[i]) freeSlots++;
+
+                const uint wrapBytes = StreamWrapElements * pStream->SampleInfo.BytesPerSample;
+                const uint sampleWords = (pDecodeWorkers && pStream->IsCompressed()) ?
+                    DECODE_AHEAD_BUFFER_SIZE : CONFIG_STREAM_BUFFER_SIZE;
+                for (uint bufferBytes = StreamBufferBytes(pStream->SampleInfo.BytesPerSample, wrapBytes, sampleWords);
+                     bufferBytes > wrapBytes; bufferBytes >>= 1)
+                {
+                    const uint slots = uint(
+                        (bufferBytes + wrapBytes + StreamSlotSize - 1) / StreamSlotSize
+                    );
+                    if (slots > 1 && slots + streamsWithoutBuffer > freeSlots) continue;
+                    // search for enough adjacent free slots
+                    for (uint first = 0, n = 0; first + n < StreamSlotUsed.size(); ) {
+                        if (StreamSlotUsed[first + n]) {
+                            first += n + 1;
+                            n = 0;
+                        } else if (++n == slots) {
+                            for (uint i = first; i < first + slots; i++) StreamSlotUsed[i] = true;
+                            pStream->SetBufferMemory(
+                                pStreamArena + first * StreamSlotSize,
+                                slots * StreamSlotSize, bufferBytes, wrapBytes
+                            );
+                            return true;
+                        }
+                    }
+                }
+                return false;
+            }
+
+            void ReleaseStreamBuffer(Stream* pStream) {
+                const uint first = uint((pStream->pBufferMemory - pStreamArena) / StreamSlotSize);
+                const uint slots = uint(pStream->BufferMemorySize / StreamSlotSize);
+                for (uint i = first; i < first + slots; i++) StreamSlotUsed[i] = false;
+                pStream->pBufferMemory    = NULL;
+                pStream->BufferMemorySize = 0;
+            }
+
             virtual void LaunchStream (
                 Stream*               pStream,
                 Stream::Handle        hStream,
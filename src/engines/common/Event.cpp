@@ -35,6 +35,7 @@ namespace LinuxSampler {
         uiSampleRate       = SampleRate;
         uiSamplesProcessed = 0;
         FragmentTime.end   = RTMath::CreateTimeStamp();
+        FragmentTime.sample_ratio = 0;
         uiTotalSamplesProcessed = 0;
     }
 
@@ -47,14 +48,29 @@ namespace LinuxSampler {
      *                           audio fragment cycle
      */
     void EventGenerator::UpdateFragmentTime(uint SamplesToProcess) {
+        UpdateFragmentTime(SamplesToProcess, RTMath::CreateTimeStamp());
+    }
+
+    /**
+     * Same as above, but with the given time stamp for the end of the
+     * current audio fragment instead of the current time. This is used when
+     * the audio output device renders a driver's period in several blocks
+     * (see AudioOutputDevice::RenderTimeStamp()).
+     *
+     * @param SamplesToProcess - number of sample points to process in this
+     *                           audio fragment cycle
+     * @param FragmentEnd      - time stamp of the end of this audio fragment
+     */
+    void EventGenerator::UpdateFragmentTime(uint SamplesToProcess, RTMath::time_stamp_t FragmentEnd) {
         // update total amount of sample points being processed since this object was created
         uiTotalSamplesProcessed += uiSamplesProcessed;
         // update time stamp for this audio fragment cycle
         FragmentTime.begin = FragmentTime.end;
-        FragmentTime.end   = RTMath::CreateTimeStamp();
+        FragmentTime.end   = FragmentEnd;
         // recalculate sample ratio for this audio fragment
         time_stamp_t fragmentDuration = FragmentTime.end - FragmentTime.begin;
-        FragmentTime.sample_ratio = (float) uiSamplesProcessed / (float) fragmentDuration;
+        if (fragmentDuration) // might be zero for very short blocks
+            FragmentTime.sample_ratio = (float) uiSamplesProcessed / (float) fragmentDuration;
         // store amount of samples to process for the next cycle
         uiSamplesProcessed = SamplesToProcess;
     }
@@ -58,6 +58,7 @@ namespace LinuxSampler {
         public:
             EventGenerator(uint SampleRate);
             void UpdateFragmentTime(uint SamplesToProcess);
+            void UpdateFragmentTime(uint SamplesToProcess, RTMath::time_stamp_t FragmentEnd);
             Event CreateEvent();
             Event CreateEvent(int32_t FragmentPos);
 
@@ -24,28 +24,86 @@
 #include "SampleFile.h"
 #include "../../common/global_private.h"
 #include "../../common/Exception.h"
+#include "../../common/HugePageAllocator.h"
+#include "../../common/lsatomic.h"
 
 #include <cstring>
 
+#if !defined(WIN32)
+# include <fcntl.h>
+# include <unistd.h>
+#endif
+
 #define CONVERT_BUFFER_SIZE 4096
 
 namespace LinuxSampler {
-    #if CONFIG_DEVMODE
-    int SampleFile_OpenFilesCount = 0;
-    #endif
+    // pool of open sample files, most recently used ones first
+    static Mutex OpenFilesMutex;
+    static std::list<SampleFile*> OpenFiles;
+    static int OpenFilesSize = 0; // std::list::size() is O(n) with some STL implementations
+    static int OpeningFiles = 0; // files being opened right now, each has a slot of the pool reserved
+
+#if !defined(WIN32)
+    static uint32_t readLE32(const uint8_t* p) {
+        return p[0] | (p[1] << 8) | (p[2] << 16) | (uint32_t(p[3]) << 24);
+    }
+
+    static uint32_t readBE32(const uint8_t* p) {
+        return (uint32_t(p[0]) << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+    }
+
+    /**
+     * Returns the byte offset of the sample data chunk of the given WAV or
+     * AIFF file, or -1 if it could not be found or if it is smaller than
+     * @a DataSize bytes.
+     */
+    static int64_t pcmDataOffset(const String& File, bool bAiff, int64_t DataSize) {
+        int fd = open(File.c_str(), O_RDONLY);
+        if (fd < 0) return -1;
+        int64_t result = -1;
+        uint8_t header[16];
+        if (pread(fd, header, 12, 0) == 12 && (bAiff ?
+            !memcmp(header, "FORM", 4) && !memcmp(header + 8, "AIFF", 4) :
+            !memcmp(header, "RIFF", 4) && !memcmp(header + 8, "WAVE", 4)))
+        {
+            // walk through the chunks until the sample data chunk is found
+            int64_t pos = 12;
+            while (pread(fd, header, 16, pos) >= 8) {
+                const int64_t size = bAiff ? readBE32(header + 4) : readLE32(header + 4);
+                if (!bAiff && !memcmp(header, "data", 4)) {
+                    if (size >= DataSize) result = pos + 8;
+                    break;
+                }
+                if (bAiff && !memcmp(header, "SSND", 4)) {
+                    // SSND chunk starts with offset and block size fields
+                    const int64_t offset = readBE32(header + 8);
+                    if (size - 8 - offset >= DataSize) result = pos + 16 + offset;
+                    break;
+                }
+                pos += 8 + size + (size & 1); // chunks are padded to even size
+            }
+        }
+        close(fd);
+        return result;
+    }
+#endif
 
     SampleFile::SampleFile(String File, bool DontClose) {
         this->File      = File;
         this->pSndFile  = NULL;
+        FileDescriptor  = -1;
+        RawDataOffset   = -1;
+        RawSwapBytes    = false;
         pConvertBuffer  = NULL;
+        HandlePos       = 0;
+        HandleUsers     = 0;
+        Pos             = 0;
+        RAMCacheSize.store(0, memory_order_relaxed);
 
         SF_INFO sfInfo;
         sfInfo.format = 0;
-        pSndFile = sf_open(File.c_str(), SFM_READ, &sfInfo);
-        if(pSndFile == NULL) throw Exception(File + ": Can't get sample info: " + String(sf_strerror (NULL)));
-        #if CONFIG_DEVMODE
-        std::cout << "Number of opened sample files: " << ++SampleFile_OpenFilesCount << std::endl;
-        #endif
+        SNDFILE* pFile = sf_open(File.c_str(), SFM_READ, &sfInfo);
+        if(pFile == NULL) throw Exception(File + ": Can't get sample info: " + String(sf_strerror (NULL)));
         SampleRate = sfInfo.samplerate;
         ChannelCount = sfInfo.channels;
         Format = sfInfo.format;
@@ -75,7 +133,7 @@ namespace LinuxSampler {
         LoopStart = 0;
         LoopEnd = 0;
         SF_INSTRUMENT instrument;
-        if (sf_command(pSndFile, SFC_GET_INSTRUMENT,
+        if (sf_command(pFile, SFC_GET_INSTRUMENT,
                        &instrument, sizeof(instrument)) != SF_FALSE) {
             // TODO: instrument.basenote
 #if HAVE_SF_INSTRUMENT_LOOPS
@@ -86,7 +144,29 @@ namespace LinuxSampler {
             }
 #endif
         }
-        if(!DontClose) Close();
+        if (sf_close(pFile)) std::cerr << "Sample::SampleFile() " << "Failed to close " << File << std::endl;
+
+#if !defined(WIN32)
+        // uncompressed 16 and 24 bit PCM can be read directly from the file,
+        // only the byte order might have to be converted to the one the
+        // synthesizer expects (native 16 bit, little endian 24 bit)
+        const int type = Format & SF_FORMAT_TYPEMASK;
+        const int subtype = Format & SF_FORMAT_SUBMASK;
+        if ((type == SF_FORMAT_WAV || type == SF_FORMAT_WAVEX || type == SF_FORMAT_AIFF) &&
+            (subtype == SF_FORMAT_PCM_16 || subtype == SF_FORMAT_PCM_24) &&
+            (Format & SF_FORMAT_ENDMASK) == SF_ENDIAN_FILE)
+        {
+            const bool bAiff = (type == SF_FORMAT_AIFF);
+            RawDataOffset = pcmDataOffset(File, bAiff, int64_t(TotalFrameCount) * FrameSize);
+#if WORDS_BIGENDIAN
+            RawSwapBytes = (subtype == SF_FORMAT_PCM_16) ? !bAiff : bAiff;
+#else
+            RawSwapBytes = bAiff;
+#endif
+        }
+#endif
+
+        if (DontClose) Open();
 
         if (FrameSize == 3 * ChannelCount && (
 #if HAVE_DECL_SF_FORMAT_FLAC
@@ -99,51 +179,182 @@ namespace LinuxSampler {
     }
 
     SampleFile::~SampleFile() {
-        Close();
+        {
+            LockGuard lock(OpenFilesMutex);
+            if (IsOpen()) RemoveOpenFile();
+        }
         ReleaseSampleData();
         delete[] pConvertBuffer;
     }
 
+    /**
+     * Makes sure the file is open. This is not required before reading,
+     * since the reading methods open the file on demand anyway. The file
+     * might be closed again at any time to make room for other files.
+     */
     void SampleFile::Open() {
-        if(pSndFile) return; // Already opened
-        SF_INFO sfInfo;
-        sfInfo.format = 0;
-        pSndFile = sf_open(File.c_str(), SFM_READ, &sfInfo);
-        if(pSndFile == NULL) throw Exception(File + ": Can't load sample");
+        if (!AcquireHandle()) throw Exception(File + ": Can't load sample");
+        ReleaseHandle();
+    }
+
+    void SampleFile::Close() {
+        LockGuard lock(OpenFilesMutex);
+        if (!IsOpen() || HandleUsers) return;
+        RemoveOpenFile();
+    }
+
+    /**
+     * Returns the amount of sample files currently open.
+     */
+    int SampleFile::OpenFilesCount() {
+        LockGuard lock(OpenFilesMutex);
+        return OpenFilesSize;
+    }
+
+    bool SampleFile::IsCompressed() const {
+        return
+#if HAVE_DECL_SF_FORMAT_FLAC
+            (Format & SF_FORMAT_TYPEMASK) == SF_FORMAT_FLAC ||
+#endif
+#if HAVE_DECL_SF_FORMAT_VORBIS
+            (Format & SF_FORMAT_SUBMASK) == SF_FORMAT_VORBIS ||
+#endif
+            false;
+    }
+
+    /**
+     * Closes the least recently used files which are not being read from,
+     * until at most @a MaxFiles files are open. Must be called with
+     * OpenFilesMutex locked.
+     */
+    void SampleFile::CloseUnusedFiles(int MaxFiles) {
+        std::list<SampleFile*>::iterator it = OpenFiles.end();
+        while (OpenFilesSize > MaxFiles && it != OpenFiles.begin()) {
+            SampleFile* pFile = *--it;
+            if (pFile->HandleUsers) continue;
+            ++it; // RemoveOpenFile() invalidates the iterator of pFile
+            pFile->RemoveOpenFile();
+        }
+    }
+
+    /**
+     * Inserts this file (which must just have been opened) at the front of
+     * the pool of open files. Must be called with OpenFilesMutex locked.
+     */
+    void SampleFile::AddOpenFile() {
+        HandlePos = 0;
+        OpenFiles.push_front(this);
+        itOpenFile = OpenFiles.begin();
+        ++OpenFilesSize;
         #if CONFIG_DEVMODE
-        std::cout << "Number of opened sample files: " << ++SampleFile_OpenFilesCount << std::endl;
+        std::cout << "Number of opened sample files: " << OpenFilesSize << std::endl;
         #endif
     }
 
-    void SampleFile::Close() {
-        if(pSndFile == NULL) return;
-        if(sf_close(pSndFile)) std::cerr << "Sample::Close() " << "Failed to close " << File << std::endl;
-        pSndFile = NULL;
+    /**
+     * Closes this file and removes it from the pool of open files. Must be
+     * called with OpenFilesMutex locked.
+     */
+    void SampleFile::RemoveOpenFile() {
+        if (pSndFile) {
+            if(sf_close(pSndFile)) std::cerr << "Sample::Close() " << "Failed to close " << File << std::endl;
+            pSndFile = NULL;
+        }
+#if !defined(WIN32)
+        if (FileDescriptor >= 0) {
+            if (close(FileDescriptor)) std::cerr << "Sample::Close() " << "Failed to close " << File << std::endl;
+            FileDescriptor = -1;
+        }
+#endif
+        OpenFiles.erase(itOpenFile);
+        --OpenFilesSize;
         #if CONFIG_DEVMODE
-        std::cout << "Number of opened sample files: " << --SampleFile_OpenFilesCount << std::endl;
+        std::cout << "Number of opened sample files: " << OpenFilesSize << std::endl;
         #endif
     }
 
+    /**
+     * Opens the file if it is currently closed and marks it as most recently
+     * used. The file is guaranteed to stay open until ReleaseHandle() is
+     * called. This is also called by the disk thread and the decode workers,
+     * so it does not throw if the file could not be (re)opened, but logs the
+     * failure and returns false instead.
+     *
+     * @returns true if the file is open and ReleaseHandle() has to be called
+     */
+    bool SampleFile::AcquireHandle() {
+        {
+            LockGuard lock(OpenFilesMutex);
+            if (IsOpen()) {
+                OpenFiles.splice(OpenFiles.begin(), OpenFiles, itOpenFile);
+                ++HandleUsers;
+                return true;
+            }
+        }
+
+        // The file has to be opened. Only the slot in the pool is reserved
+        // under OpenFilesMutex, the (possibly slow) open itself is done
+        // without it, so readers of other files are not blocked meanwhile.
+        LockGuard openLock(OpenMutex); // only one thread opens this file
+        {
+            LockGuard lock(OpenFilesMutex);
+            if (IsOpen()) { // opened by another thread meanwhile
+                OpenFiles.splice(OpenFiles.begin(), OpenFiles, itOpenFile);
+                ++HandleUsers;
+                return true;
+            }
+            CloseUnusedFiles(CONFIG_MAX_OPEN_SAMPLE_FILES - 1 - OpeningFiles);
+            ++OpeningFiles;
+        }
+
+        SNDFILE* pNewSndFile = NULL;
+        int newFileDescriptor = -1;
+#if !defined(WIN32)
+        if (RawDataOffset >= 0) {
+            newFileDescriptor = open(File.c_str(), O_RDONLY);
+        } else
+#endif
+        {
+            SF_INFO sfInfo;
+            sfInfo.format = 0;
+            pNewSndFile = sf_open(File.c_str(), SFM_READ, &sfInfo);
+        }
+
+        LockGuard lock(OpenFilesMutex);
+        --OpeningFiles;
+        if (!pNewSndFile && newFileDescriptor < 0) {
+            std::cerr << "Sample::AcquireHandle() " << "Failed to open " << File << std::endl;
+            return false;
+        }
+        pSndFile = pNewSndFile;
+        FileDescriptor = newFileDescriptor;
+        AddOpenFile();
+        ++HandleUsers;
+        return true;
+    }
+
+    void SampleFile::ReleaseHandle() {
+        LockGuard lock(OpenFilesMutex);
+        --HandleUsers;
+    }
+
     long SampleFile::SetPos(unsigned long FrameOffset) {
         return SetPos(FrameOffset, SEEK_SET);
     }
 
     long SampleFile::SetPos(unsigned long FrameCount, int Whence) {
-        if(pSndFile == NULL) {
-            std::cerr << "Sample::SetPos() " << File << " not opened" << std::endl;
-            return -1;
+        long NewPos;
+        switch (Whence) {
+            case SEEK_SET: NewPos = FrameCount; break;
+            case SEEK_CUR: NewPos = Pos + FrameCount; break;
+            default:       return -1;
         }
-
-        return sf_seek(pSndFile, FrameCount, Whence);
+        if (NewPos < 0 || NewPos > TotalFrameCount) return -1;
+        return Pos = NewPos;
     }
 
     long SampleFile::GetPos() {
-        if(pSndFile == NULL) {
-            std::cerr << "Sample::GetPos() " << File << " not opened" << std::endl;
-            return -1;
-        }
-
-        return sf_seek(pSndFile, 0, SEEK_CUR);
+        return Pos;
     }
 
     Sample::buffer_t SampleFile::LoadSampleData() {
@@ -159,7 +370,6 @@ namespace LinuxSampler {
     }
 
     Sample::buffer_t SampleFile::LoadSampleDataWithNullSamplesExtension(unsigned long FrameCount, uint NullFramesCount) {
-        Open();
         if (FrameCount > GetTotalFrameCount()) FrameCount = GetTotalFrameCount();
         
         if (Offset > MaxOffset && FrameCount < GetTotalFrameCount()) {
@@ -167,24 +377,104 @@ namespace LinuxSampler {
             // Offset the RAM cache
             RAMCacheOffset = Offset;
         }
-        if (RAMCache.pStart) delete[] (int8_t*) RAMCache.pStart;
+        ReleaseSampleData();
         unsigned long allocationsize = (FrameCount + NullFramesCount) * this->FrameSize;
-        SetPos(RAMCacheOffset, SEEK_SET); // reset read position to playback start point
-        RAMCache.pStart            = new int8_t[allocationsize];
+        RAMCache.pStart            = HugePageAllocator::Allocate(allocationsize);
+        if (!RAMCache.pStart) throw Exception(File + ": Can't allocate RAM cache");
 
-        RAMCache.Size = Read(RAMCache.pStart, FrameCount) * this->FrameSize;
-        RAMCache.NullExtensionSize = allocationsize - RAMCache.Size;
+        // read from playback start point (the file is left open, since it
+        // will most probably be streamed from soon)
+        const unsigned long size = ReadAt(RAMCacheOffset, RAMCache.pStart, FrameCount) * this->FrameSize;
+        RAMCache.NullExtensionSize = allocationsize - size;
         // fill the remaining buffer space with silence samples
-        memset((int8_t*)RAMCache.pStart + RAMCache.Size, 0, RAMCache.NullExtensionSize);
-        Close();
+        memset((int8_t*)RAMCache.pStart + size, 0, RAMCache.NullExtensionSize);
+        RAMCache.Size = size;
+        // with lazy sample loading the audio thread might already check the
+        // cache size meanwhile, so publish it after the cache is complete
+        RAMCacheSize.store(int(size), memory_order_release);
         return GetCache();
     }
 
     long SampleFile::Read(void* pBuffer, unsigned long FrameCount) {
-        Open();
-        
-        if (GetPos() + FrameCount > GetTotalFrameCount()) FrameCount = GetTotalFrameCount() - GetPos(); // For the cases where a different sample end is specified (not the end of the file)
+        long n = ReadAt(Pos, pBuffer, FrameCount);
+        if (n > 0) Pos += n;
+        return n;
+    }
+
+    /**
+     * Reads @a FrameCount frames starting at frame @a FramePos into
+     * @a pBuffer. Unlike Read(), this does not depend on or change the
+     * position set with SetPos(), so several streams can read from the same
+     * sample concurrently.
+     *
+     * @returns number of frames actually read
+     */
+    long SampleFile::ReadAt(unsigned long FramePos, void* pBuffer, unsigned long FrameCount) {
+        // For the cases where a different sample end is specified (not the end of the file)
+        const unsigned long TotalFrames = GetTotalFrameCount();
+        if (FramePos >= TotalFrames) return 0;
+        if (FramePos + FrameCount > TotalFrames) FrameCount = TotalFrames - FramePos;
+
+        if (RawDataOffset >= 0) return ReadRaw(FramePos, pBuffer, FrameCount);
+
+        LockGuard lock(ReadMutex);
+        if (!AcquireHandle()) return 0;
+        long n = 0;
+        if (HandlePos == long(FramePos) || sf_seek(pSndFile, FramePos, SEEK_SET) == sf_count_t(FramePos)) {
+            n = ReadFrames(pBuffer, FrameCount);
+            HandlePos = (n < 0) ? -1 : FramePos + n;
+        } else {
+            HandlePos = -1;
+        }
+        ReleaseHandle();
+        return (n < 0) ? 0 : n;
+    }
+
+    /**
+     * Reads uncompressed PCM data directly from the file. Since pread() does
+     * not use the file's position, no locking is required here.
+     */
+    long SampleFile::ReadRaw(unsigned long FramePos, void* pBuffer, unsigned long FrameCount) {
+#if defined(WIN32)
+        return 0;
+#else
+        if (!AcquireHandle()) return 0;
+        uint8_t* const pDst = static_cast<uint8_t*>(pBuffer);
+        const size_t bytes = size_t(FrameCount) * FrameSize;
+        size_t done = 0;
+        while (done < bytes) {
+            ssize_t n = pread(FileDescriptor, pDst + done, bytes - done,
+                              RawDataOffset + int64_t(FramePos) * FrameSize + done);
+            if (n <= 0) break;
+            done += n;
+        }
+        ReleaseHandle();
+        FrameCount = done / FrameSize;
+
+        if (RawSwapBytes) {
+            const size_t n = FrameCount * ChannelCount;
+            if (FrameSize == 2 * ChannelCount) {
+                for (size_t i = 0; i < n; ++i) {
+                    const uint8_t b = pDst[2 * i];
+                    pDst[2 * i]     = pDst[2 * i + 1];
+                    pDst[2 * i + 1] = b;
+                }
+            } else {
+                for (size_t i = 0; i < n; ++i) {
+                    const uint8_t b = pDst[3 * i];
+                    pDst[3 * i]     = pDst[3 * i + 2];
+                    pDst[3 * i + 2] = b;
+                }
+            }
+        }
+        return FrameCount;
+#endif
+    }
 
+    /**
+     * Reads from the current position of pSndFile.
+     */
+    long SampleFile::ReadFrames(void* pBuffer, unsigned long FrameCount) {
         // ogg and flac files must be read with sf_readf, not
         // sf_read_raw. On big endian machines, sf_readf_short is also
         // used for 16 bit wav files, to get automatic endian
@@ -247,23 +537,24 @@ namespace LinuxSampler {
         PlaybackState*  pPlaybackState
     ) {
         // TODO:
-        SetPos(pPlaybackState->position);
-        unsigned long count = Read(pBuffer, FrameCount);
-        pPlaybackState->position = GetPos();
+        unsigned long count = ReadAt(pPlaybackState->position, pBuffer, FrameCount);
+        pPlaybackState->position += count;
         return count;
     }
 
     void SampleFile::ReleaseSampleData() {
-        if (RAMCache.pStart) delete[] (int8_t*) RAMCache.pStart;
+        RAMCacheSize.store(0, memory_order_release);
+        if (RAMCache.pStart) HugePageAllocator::Free(RAMCache.pStart, RAMCache.Size + RAMCache.NullExtensionSize);
         RAMCache.pStart = NULL;
         RAMCache.Size   = 0;
         RAMCache.NullExtensionSize = 0;
     }
 
     Sample::buffer_t SampleFile::GetCache() {
-        // return a copy of the buffer_t structure
+        // return a copy of the buffer_t structure, the size has to be read
+        // first (see RAMCacheSize)
         buffer_t result;
-        result.Size              = this->RAMCache.Size;
+        result.Size              = this->RAMCacheSize.load(memory_order_acquire);
         result.pStart            = this->RAMCache.pStart;
         result.NullExtensionSize = this->RAMCache.NullExtensionSize;
         return result;
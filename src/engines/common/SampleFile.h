@@ -27,9 +27,26 @@
 #include "Sample.h"
 
 #include <sndfile.h>
+#include <list>
 #include "../../common/global.h"
+#include "../../common/Mutex.h"
+#include "../../common/lsatomic.h"
 
 namespace LinuxSampler {
+    /**
+     * Sample read from an audio file by libsndfile.
+     *
+     * To avoid running out of file descriptors with instruments consisting
+     * of thousands of sample files, the files are not kept open all the
+     * time. Instead all SampleFile instances share a pool of at most
+     * CONFIG_MAX_OPEN_SAMPLE_FILES open files, the least recently used file
+     * is closed when another one has to be opened. Files are (re)opened on
+     * demand by the reading methods, which are only called by the disk
+     * thread and by the instrument loading thread.
+     *
+     * Uncompressed 16 and 24 bit PCM data of WAV and AIFF files is read
+     * directly from the file with pread() instead of by libsndfile.
+     */
     class SampleFile : public Sample {
         public:
             SampleFile(String File, bool DontClose = false);
@@ -53,6 +70,7 @@ namespace LinuxSampler {
             virtual void      ReleaseSampleData();
             virtual buffer_t  GetCache();
             virtual long      Read(void* pBuffer, unsigned long FrameCount);
+            long              ReadAt(unsigned long FramePos, void* pBuffer, unsigned long FrameCount);
 
             virtual unsigned long ReadAndLoop (
                 void*           pBuffer,
@@ -66,6 +84,14 @@ namespace LinuxSampler {
             void Open();
             void Close();
 
+            /**
+             * Whether the sample data is compressed (FLAC or Ogg Vorbis),
+             * so that reading it requires decoding.
+             */
+            bool IsCompressed() const;
+
+            static int OpenFilesCount();
+
         private:
             String File;
             int    SampleRate;
@@ -77,13 +103,31 @@ namespace LinuxSampler {
             uint   LoopStart;
             uint   LoopEnd;
 
-            SNDFILE* pSndFile;
+            SNDFILE* pSndFile;        ///< libsndfile handle of the file, NULL if currently closed or if the file is read directly.
+            int      FileDescriptor;  ///< File descriptor used for reading uncompressed PCM data directly (see RawDataOffset), -1 if currently closed.
+            int64_t  RawDataOffset;   ///< Byte offset of the sample data within the file if it is uncompressed PCM which is read directly (bypassing libsndfile), -1 otherwise.
+            bool     RawSwapBytes;    ///< Whether the byte order of directly read sample points has to be reversed.
+            long     HandlePos;       ///< Current read position of pSndFile (in frames).
+            int      HandleUsers;     ///< Amount of reads currently using pSndFile, the file won't be closed by the pool meanwhile.
+            std::list<SampleFile*>::iterator itOpenFile; ///< Position of this file in the pool's list of open files (only valid if pSndFile is not NULL).
+            Mutex    ReadMutex;       ///< Serializes positioning and reading of pSndFile.
+            Mutex    OpenMutex;       ///< Serializes opening the file, so concurrent readers of a closed file only open it once.
+            long     Pos;             ///< Read position of Read(), SetPos() and GetPos() (in frames).
 
             buffer_t RAMCache;        ///< Buffers samples (already uncompressed) in RAM.
+            atomic<int> RAMCacheSize; ///< Size of the RAM cache in bytes as returned by GetCache(). With lazy sample loading the cache is filled by the disk thread while the audio thread might check its size, so it is published with release semantics after the cache is complete.
 
             int* pConvertBuffer;
 
             long SetPos(unsigned long FrameCount, int Whence);
+            long ReadFrames(void* pBuffer, unsigned long FrameCount);
+            long ReadRaw(unsigned long FramePos, void* pBuffer, unsigned long FrameCount);
+            bool IsOpen() const { return pSndFile || FileDescriptor >= 0; }
+            bool AcquireHandle();
+            void ReleaseHandle();
+            void AddOpenFile();
+            void RemoveOpenFile();
+            static void CloseUnusedFiles(int MaxFiles);
     };
 
     template <class R>
@@ -128,24 +172,26 @@ namespace LinuxSampler {
             ) {
                 // TODO: startAddrsCoarseOffset, endAddrsCoarseOffset
                 unsigned long samplestoread = FrameCount, totalreadsamples = 0, readsamples, samplestoloopend;
+                unsigned long pos = pPlaybackState->position;
                 uint8_t* pDst = (uint8_t*) pBuffer;
-                SetPos(pPlaybackState->position);
                 if (pRegion->HasLoop()) {
                     do {
-                        if (GetPos() > pRegion->GetLoopEnd()) SetPos(pRegion->GetLoopStart());
-                        samplestoloopend  = pRegion->GetLoopEnd() - GetPos();
-                        readsamples       = Read(&pDst[totalreadsamples * GetFrameSize()], Min(samplestoread, samplestoloopend));
+                        if (pos > pRegion->GetLoopEnd()) pos = pRegion->GetLoopStart();
+                        samplestoloopend  = pRegion->GetLoopEnd() - pos;
+                        readsamples       = ReadAt(pos, &pDst[totalreadsamples * GetFrameSize()], Min(samplestoread, samplestoloopend));
                         samplestoread    -= readsamples;
                         totalreadsamples += readsamples;
+                        pos              += readsamples;
                         if (readsamples == samplestoloopend) {
-                            SetPos(pRegion->GetLoopStart());
+                            pos = pRegion->GetLoopStart();
                         }
                     } while (samplestoread && readsamples);
                 } else {
-                    totalreadsamples = Read(pBuffer, FrameCount);
+                    totalreadsamples = ReadAt(pos, pBuffer, FrameCount);
+                    pos += totalreadsamples;
                 }
 
-                pPlaybackState->position = GetPos();
+                pPlaybackState->position = pos;
 
                 return totalreadsamples;
             }
@@ -23,35 +23,52 @@
 #ifndef __LS_SAMPLEMANAGER_H__
 #define __LS_SAMPLEMANAGER_H__
 
-#include <map>
 #include <vector>
-#include <set>
 
 #include "../../common/Exception.h"
+#include "../../common/HashMap.h"
+#include "../../common/Mutex.h"
 
 namespace LinuxSampler {
 
     /**
      * Used to determine and manage the relations between samples and consumers (e.g. regions)
+     *
+     * Libraries may consist of hundreds of thousands of samples, so the
+     * bookkeeping is kept compact: one hash map entry per sample, with its
+     * (usually only one) consumer stored inline.
+     *
+     * All methods are thread safe: samples and consumers are added and
+     * removed by the instrument loading thread, while the disk thread marks
+     * samples as (not) in use when it launches and kills streams. The
+     * On*() hooks are called with the sample manager locked. SamplesMutex
+     * is not recursive, so each public method locks it only once and uses
+     * the *_unlocked() helpers to share code with other public methods.
      */
     template <class S /* Sample */, class C /* Sample Consumer */>
     class SampleManager {
         public:
+            virtual ~SampleManager() { }
+
             /**
              * Adds the specified sample to the sample manager
              */
             void AddSample(S* pSample) {
                 if (pSample == NULL) return;
-                sampleMap[pSample];
+                LockGuard lock(SamplesMutex);
+                AddSample_unlocked(pSample);
             }
 
             void RemoveSample(S* pSample) throw (Exception) {
-                if (sampleMap.find(pSample) == sampleMap.end()) return;
-                if (!sampleMap[pSample].empty()) {
+                LockGuard lock(SamplesMutex);
+                sample_info_t* pInfo = samples.find(pSample);
+                if (!pInfo) return;
+                if (!pInfo->consumers.empty()) {
                     throw Exception("Can't remove. Sample has consumers");
                 }
 
-                sampleMap.erase(sampleMap.find(pSample));
+                samples.erase(pSample);
+                OnSampleRemoved(pSample);
             }
 
             /**
@@ -62,17 +79,20 @@ namespace LinuxSampler {
              */
             void AddSampleConsumer(S* pSample, C* pConsumer) {
                 if (pSample == NULL || pConsumer == NULL) return;
-                if(sampleMap[pSample].find(pConsumer) != sampleMap[pSample].end()) return;
-                sampleMap[pSample].insert(pConsumer);
+                LockGuard lock(SamplesMutex);
+                AddSample_unlocked(pSample);
+                samples.find(pSample)->consumers.insert(pConsumer);
             }
 
             std::vector<C*> GetConsumers(S* pSample) throw (Exception) {
-                if (sampleMap.find(pSample) == sampleMap.end()) {
+                LockGuard lock(SamplesMutex);
+                sample_info_t* pInfo = samples.find(pSample);
+                if (!pInfo) {
                     throw Exception("SampleManager::GetConsumers: unknown sample");
                 }
-                std::set<C*>* pConsumers = &sampleMap[pSample];
                 std::vector<C*> v;
-                v.insert(pConsumers->begin(), pConsumers->end());
+                for (size_t i = 0; i < pInfo->consumers.size(); i++)
+                    v.push_back(pInfo->consumers[i]);
                 return v ;
             }
 
@@ -81,83 +101,126 @@ namespace LinuxSampler {
              * of consumers for the specified sample.
              */
             bool RemoveSampleConsumer(S* pSample, C* pConsumer) throw (Exception) {
-                if (sampleMap.find(pSample) == sampleMap.end()) {
+                LockGuard lock(SamplesMutex);
+                sample_info_t* pInfo = samples.find(pSample);
+                if (!pInfo) {
                     throw Exception("SampleManager::RemoveConsumer: unknown sample");
                 }
 
-                std::set<C*>* consumers = &sampleMap[pSample];
-                typename std::set<C*>::iterator it = consumers->find(pConsumer);
-                if (it != consumers->end()) {
-                    consumers->erase(it);
-                    return true;
-                }
-                return false;
+                return pInfo->consumers.erase(pConsumer);
             }
 
             /**
              * Determines whether pSample is managed by this sample manager
              */
             bool HasSample(S* pSample) {
-                return sampleMap.find(pSample) != sampleMap.end();
+                LockGuard lock(SamplesMutex);
+                return samples.find(pSample) != NULL;
             }
 
             bool HasSampleConsumers(S* pSample) throw (Exception) {
-                if (sampleMap.find(pSample) == sampleMap.end()) {
+                LockGuard lock(SamplesMutex);
+                sample_info_t* pInfo = samples.find(pSample);
+                if (!pInfo) {
                     throw Exception("SampleManager::HasConsumers: unknown sample");
                 }
 
-                return !sampleMap[pSample].empty();
+                return !pInfo->consumers.empty();
             }
 
             /**
              * Determines whether pConsumer is consumer of pSample.
              */
             bool IsSampleConsumerOf(S* pSample, C* pConsumer) {
-                if (sampleMap.find(pSample) == sampleMap.end()) {
+                LockGuard lock(SamplesMutex);
+                sample_info_t* pInfo = samples.find(pSample);
+                if (!pInfo) {
                     throw Exception("SampleManager::IsSampleConsumerOf: unknown sample");
                 }
 
-                typename std::set<C*>::iterator it = sampleMap[pSample].find(pConsumer);
-                return it != sampleMap[pSample].end();
+                return pInfo->consumers.contains(pConsumer);
             }
 
             /**
-             * Sets that pSample is now in use by pConsumer.
+             * Sets that pSample is now in use by pConsumer. Calls of this
+             * method and of SetSampleNotInUse() must be balanced.
              */
             void SetSampleInUse(S* pSample, C* pConsumer) {
-                verifyPair(pSample, pConsumer, "SampleManager::SetSampleInUse");
+                LockGuard lock(SamplesMutex);
+                sample_info_t* pInfo = verifyPair(pSample, pConsumer, "SampleManager::SetSampleInUse");
 
-                bool inUse = !samplesInUseMap[pSample].empty();
-                samplesInUseMap[pSample].insert(pConsumer);
-                if(!inUse) OnSampleInUse(pSample);
+                if (pInfo->inUseCount++ == 0) OnSampleInUse(pSample);
             }
 
             /**
              * Sets that pSample is now not in use by pConsumer.
              */
             void SetSampleNotInUse(S* pSample, C* pConsumer) {
-                verifyPair(pSample, pConsumer, "SampleManager::SetSampleNotInUse");
+                LockGuard lock(SamplesMutex);
+                sample_info_t* pInfo = verifyPair(pSample, pConsumer, "SampleManager::SetSampleNotInUse");
+
+                if (pInfo->inUseCount == 0) return;
+                if (--pInfo->inUseCount == 0) OnSampleNotInUse(pSample);
+            }
 
-                bool inUse = !samplesInUseMap[pSample].empty();
-                samplesInUseMap[pSample].erase(pConsumer);
-                bool inUseNew = !samplesInUseMap[pSample].empty();
-                if(inUse && !inUseNew) OnSampleNotInUse(pSample);
+            /**
+             * Returns the amount of samples managed by this sample manager.
+             */
+            size_t GetSampleCount() {
+                LockGuard lock(SamplesMutex);
+                return samples.size();
+            }
+
+            /**
+             * Returns the size of the memory used for the bookkeeping of
+             * this sample manager in bytes (not including the memory for
+             * further consumers of samples with more than one consumer).
+             */
+            size_t GetMemoryUsage() {
+                LockGuard lock(SamplesMutex);
+                return samples.memoryUsage();
             }
 
         protected:
-            std::map<S*, std::set<C*> > sampleMap;
-            std::map<S*, std::set<C*> > samplesInUseMap;
+            struct sample_info_t {
+                SmallSet<C> consumers;
+                int         inUseCount; ///< Amount of SetSampleInUse() calls not yet balanced by SetSampleNotInUse().
+
+                sample_info_t() : inUseCount(0) { }
 
-            void verifyPair(S* pSample, C* pConsumer, String caller) {
-                if(!HasSample(pSample)) {
+                friend void swap(sample_info_t& a, sample_info_t& b) {
+                    a.consumers.swap(b.consumers);
+                    std::swap(a.inUseCount, b.inUseCount);
+                }
+            };
+
+            HashMap<S*, sample_info_t> samples;
+            Mutex SamplesMutex; ///< Protects samples (and the data of derived classes updated by the On*() hooks).
+
+            sample_info_t* verifyPair(S* pSample, C* pConsumer, String caller) {
+                sample_info_t* pInfo = samples.find(pSample);
+                if (!pInfo) {
                     throw Exception(caller + ": unknown sample");
                 }
 
-                if(!IsSampleConsumerOf(pSample, pConsumer)) {
-                    throw Exception("SampleManager::SetSampleInUse: unknown consumer");
+                if (!pInfo->consumers.contains(pConsumer)) {
+                    throw Exception(caller + ": unknown consumer");
                 }
+                return pInfo;
             }
 
+            /**
+             * Override this method to handle the addition of the specified
+             * sample to this sample manager.
+             */
+            virtual void OnSampleAdded(S* pSample) { }
+
+            /**
+             * Override this method to handle the removal of the specified
+             * sample from this sample manager.
+             */
+            virtual void OnSampleRemoved(S* pSample) { }
+
             /**
              * Override this method to handle the state change (not in use -> in use)
              * of the specified sample.
@@ -169,6 +232,14 @@ namespace LinuxSampler {
              * of the specified sample.
              */
             virtual void OnSampleNotInUse(S* pSample) { }
+
+        private:
+            // Body of AddSample(), SamplesMutex must be locked by the caller.
+            void AddSample_unlocked(S* pSample) {
+                if (samples.find(pSample)) return;
+                samples[pSample];
+                OnSampleAdded(pSample);
+            }
     };
 } // namespace LinuxSampler
 
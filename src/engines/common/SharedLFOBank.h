@@ -0,0 +1,199 @@
+/***************************************************************************
+ *                                                                         *
+ *   LinuxSampler - modular, streaming capable sampler                     *
+ *                                                                         *
+ *   Copyright (C) 2026 The LinuxSampler Developers                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston,                 *
+ *   MA  02111-1307  USA                                                   *
+ ***************************************************************************/
+
+#ifndef __LS_SHAREDLFOBANK_H__
+#define __LS_SHAREDLFOBANK_H__
+
+#include <stdint.h>
+#include "LFOBase.h"
+#include "Event.h"
+#include "../../common/global_private.h"
+
+// amount of different shared LFOs an engine channel can have per LFO type
+#define SHARED_LFOS  16
+
+namespace LinuxSampler {
+
+    /** @brief Shared LFOs of an engine channel
+     *
+     * LFOs which are not restarted on note-on, but run freely for all voices
+     * of an engine channel (like the gig format's "LFO sync" option), are
+     * rendered only once per audio fragment by this bank and shared by all
+     * voices using an LFO with the same settings. Each shared LFO renders
+     * one level per subfragment of the current audio fragment, which the
+     * voices read instead of rendering their own LFO.
+     *
+     * A shared LFO keeps running as long as at least one voice uses it. If
+     * more different settings are in use than the bank has room for, the
+     * voices have to fall back to their own LFO.
+     *
+     * All methods except Resize() must only be called by the audio thread.
+     */
+    template<class LFO>
+    class SharedLFOBank {
+        public:
+            /// Settings of a shared LFO, as passed to LFOBase::trigger().
+            struct params_t {
+                float         Frequency;
+                start_level_t StartLevel;
+                uint16_t      InternalDepth;
+                uint16_t      ExtControlDepth;
+                bool          FlipPhase;
+                uint8_t       ExtController; ///< MIDI controller number modulating the depth, 0 for none
+                unsigned int  SampleRate;    ///< LFO sample rate (that is engine sample rate / subfragment size)
+
+                bool operator==(const params_t& o) const {
+                    return Frequency == o.Frequency && StartLevel == o.StartLevel &&
+                           InternalDepth == o.InternalDepth &&
+                           ExtControlDepth == o.ExtControlDepth &&
+                           FlipPhase == o.FlipPhase &&
+                           ExtController == o.ExtController &&
+                           SampleRate == o.SampleRate;
+                }
+            };
+
+            /**
+             * @param Max              - maximum value of the output levels
+             * @param pControllerTable - current MIDI controller values of the
+             *                           engine channel
+             */
+            SharedLFOBank(float Max, const uint8_t* pControllerTable) :
+                pControllerTable(pControllerTable), MaxSubfragments(0)
+            {
+                for (int i = 0; i < SHARED_LFOS; i++) {
+                    slots[i].pLFO      = new LFO(Max);
+                    slots[i].pLevels   = NULL;
+                    slots[i].RefCount  = 0;
+                    slots[i].bRendered = false;
+                }
+            }
+
+            ~SharedLFOBank() {
+                for (int i = 0; i < SHARED_LFOS; i++) {
+                    delete slots[i].pLFO;
+                    if (slots[i].pLevels) delete[] slots[i].pLevels;
+                }
+            }
+
+            /**
+             * Allocates the level buffers for audio fragments of up to
+             * @a MaxSamplesPerCycle sample points. Not real-time safe, and
+             * must not be called while voices of the engine channel are
+             * rendered.
+             */
+            void Resize(uint MaxSamplesPerCycle) {
+                const uint subfragments =
+                    (MaxSamplesPerCycle + CONFIG_DEFAULT_SUBFRAGMENT_SIZE - 1) / CONFIG_DEFAULT_SUBFRAGMENT_SIZE;
+                if (subfragments <= MaxSubfragments) return;
+                for (int i = 0; i < SHARED_LFOS; i++) {
+                    if (slots[i].pLevels) delete[] slots[i].pLevels;
+                    slots[i].pLevels   = new float[subfragments];
+                    slots[i].bRendered = false;
+                }
+                MaxSubfragments = subfragments;
+            }
+
+            /**
+             * Returns the shared LFO with the given settings, which is
+             * triggered first if no voice uses such an LFO yet.
+             *
+             * @returns index of the shared LFO, -1 if there is no free slot
+             */
+            int Acquire(const params_t& Params) {
+                if (!MaxSubfragments) return -1;
+                int iFree = -1;
+                for (int i = 0; i < SHARED_LFOS; i++) {
+                    if (!slots[i].RefCount) {
+                        if (iFree < 0) iFree = i;
+                    } else if (slots[i].Params == Params) {
+                        slots[i].RefCount++;
+                        return i;
+                    }
+                }
+                if (iFree < 0) return -1;
+                slot_t& slot = slots[iFree];
+                slot.Params    = Params;
+                slot.RefCount  = 1;
+                slot.bRendered = false;
+                slot.pLFO->ExtController = Params.ExtController;
+                slot.pLFO->trigger(
+                    Params.Frequency, Params.StartLevel, Params.InternalDepth,
+                    Params.ExtControlDepth, Params.FlipPhase, Params.SampleRate
+                );
+                slot.pLFO->update(Params.ExtController ? pControllerTable[Params.ExtController] : 0);
+                return iFree;
+            }
+
+            /**
+             * Drops a reference to the shared LFO @a Index returned by
+             * Acquire().
+             */
+            void Release(int Index) {
+                if (Index < 0 || !slots[Index].RefCount) return;
+                slots[Index].RefCount--;
+            }
+
+            /**
+             * Returns the levels of the shared LFO @a Index for the audio
+             * fragment starting at @a FrameTime, one level per subfragment.
+             * The levels are rendered by the first voice asking for them in
+             * that fragment.
+             *
+             * @returns levels or NULL if the fragment is larger than the
+             *          bank was sized for by Resize()
+             */
+            const float* Levels(int Index, sched_time_t FrameTime, uint Samples) {
+                slot_t& slot = slots[Index];
+                if (slot.bRendered && slot.RenderedTime == FrameTime)
+                    return slot.pLevels;
+                const uint subfragments =
+                    (Samples + CONFIG_DEFAULT_SUBFRAGMENT_SIZE - 1) / CONFIG_DEFAULT_SUBFRAGMENT_SIZE;
+                if (subfragments > MaxSubfragments) return NULL;
+                // depth changes by the external controller are applied once
+                // per fragment for shared LFOs
+                if (slot.Params.ExtController)
+                    slot.pLFO->update(pControllerTable[slot.Params.ExtController]);
+                for (uint i = 0; i < subfragments; i++)
+                    slot.pLevels[i] = slot.pLFO->render();
+                slot.RenderedTime = FrameTime;
+                slot.bRendered    = true;
+                return slot.pLevels;
+            }
+
+        private:
+            struct slot_t {
+                LFO*         pLFO;
+                float*       pLevels;      ///< one level per subfragment of the fragment at RenderedTime
+                params_t     Params;
+                int          RefCount;     ///< amount of voices using this LFO
+                bool         bRendered;    ///< whether pLevels is valid for RenderedTime
+                sched_time_t RenderedTime; ///< FrameTime of the fragment pLevels was rendered for
+            };
+
+            slot_t         slots[SHARED_LFOS];
+            const uint8_t* pControllerTable;
+            uint           MaxSubfragments;
+    };
+
+} // namespace LinuxSampler
+
+#endif // __LS_SHAREDLFOBANK_H__
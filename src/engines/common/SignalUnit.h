@@ -281,6 +281,13 @@ namespace LinuxSampler {
              */
             virtual float GetVolume() = 0;
 
+            /**
+             * Gets the volume modulation value of the amplitude envelope(s)
+             * for the current time step, that is GetVolume() without any
+             * LFO modulation.
+             */
+            virtual float GetEnvelopeVolume() { return GetVolume(); }
+
             /**
              * Gets the filter cutoff frequency modulation value
              * for the current time step (sample point).
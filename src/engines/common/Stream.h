@@ -64,17 +64,37 @@ namespace LinuxSampler {
                     int TotalSampleCount;
             };
 
-            Stream(uint BufferSize, uint BufferWrapElements) {
+            /**
+             * @param BufferSize - ring buffer size in sample words
+             * @param BufferWrapElements - wrap space in sample words
+             * @param pBufferMemory - (optional) memory to be used for the
+             *        ring buffer, must be at least
+             *        RingBufferMemorySize(BufferSize, BufferWrapElements)
+             *        bytes large; if NULL the stream has no ring buffer
+             *        memory until the disk thread assigns some with
+             *        SetBufferMemory() when launching the stream
+             */
+            Stream(uint BufferSize, uint BufferWrapElements, uint8_t* pBufferMemory = NULL) {
                 this->pExportReference       = NULL;
                 this->State                  = state_unused;
                 this->hThis                  = 0;
                 this->PlaybackState.position = 0;
                 this->PlaybackState.reverse  = false;
-                this->pRingBuffer            = new RingBuffer<uint8_t,false>(BufferSize * 3, BufferWrapElements * 3);
+                this->pRingBuffer            = new RingBuffer<uint8_t,false>(BufferSize * 3, BufferWrapElements * 3, pBufferMemory);
+                this->pBufferMemory          = pBufferMemory;
+                this->BufferMemorySize       = (pBufferMemory) ? RingBufferMemorySize(BufferSize, BufferWrapElements) : 0;
                 UnusedStreams++;
                 TotalStreams++;
             }
 
+            /**
+             * Returns the size in bytes of the ring buffer of a stream
+             * created with the given buffer size and wrap elements.
+             */
+            static size_t RingBufferMemorySize(uint BufferSize, uint BufferWrapElements) {
+                return RingBuffer<uint8_t,false>::requiredElements(BufferSize * 3, BufferWrapElements * 3);
+            }
+
             virtual ~Stream() { }
 
             // Methods
@@ -114,6 +134,16 @@ namespace LinuxSampler {
             virtual int  ReadAhead(unsigned long SampleCount) = 0;
             virtual void WriteSilence(unsigned long SilenceSampleWords) = 0;
 
+            /**
+             * Whether the sample currently streamed is compressed (e.g.
+             * FLAC), so that refilling it is CPU bound. Such streams are
+             * refilled concurrently by the disk thread's decode workers
+             * (see DecodeWorkerPool), so an implementation must only
+             * return true if ReadAhead() may be called concurrently for
+             * different streams.
+             */
+            virtual bool IsCompressed() { return false; }
+
             // Static Method
             inline static uint       GetUnusedStreams() { return UnusedStreams; }
 
@@ -122,6 +152,8 @@ namespace LinuxSampler {
         protected:
             // Attributes
             RingBuffer<uint8_t,false>*  pRingBuffer;
+            uint8_t*                    pBufferMemory;    ///< Memory used by @c pRingBuffer (not owned by the stream), NULL if none assigned.
+            size_t                      BufferMemorySize; ///< Size of @c pBufferMemory in bytes.
             SampleDescription           SampleInfo;
             Sample::PlaybackState       PlaybackState;
             reference_t*                pExportReference;
@@ -143,6 +175,18 @@ namespace LinuxSampler {
                 this->State = State;
             }
 
+            /**
+             * Lets the ring buffer use the given memory of @a MemorySize
+             * bytes from now on, which provides @a BufferBytes bytes (a
+             * power of two) of buffer plus @a WrapBytes bytes of wrap space.
+             * Only called by the disk thread, while the stream is not read.
+             */
+            void SetBufferMemory(uint8_t* pMemory, size_t MemorySize, uint BufferBytes, uint WrapBytes) {
+                pRingBuffer->attach(BufferBytes - WrapBytes, WrapBytes, pMemory);
+                pBufferMemory    = pMemory;
+                BufferMemorySize = MemorySize;
+            }
+
             virtual long Read(uint8_t* pBuf, long SamplesToRead) = 0;
             virtual void Reset() = 0;
 
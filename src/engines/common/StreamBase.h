@@ -43,7 +43,7 @@ namespace LinuxSampler {
     class StreamBase : public Stream {
         public:
             // Methods
-            StreamBase(uint BufferSize, uint BufferWrapElements) : Stream(BufferSize, BufferWrapElements) {
+            StreamBase(uint BufferSize, uint BufferWrapElements, uint8_t* pBufferMemory = NULL) : Stream(BufferSize, BufferWrapElements, pBufferMemory) {
                 this->pRegion      = NULL;
                 this->SampleOffset = 0;
             }
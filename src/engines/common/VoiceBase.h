@@ -37,6 +37,7 @@ namespace LinuxSampler {
             int  RealSampleWordsLeftToRead; ///< Number of samples left to read, not including the silence added for the interpolator
 
             VoiceBase(SignalUnitRack* pRack = NULL): AbstractVoice(pRack) {
+                StreamOnly   = false;
                 pRegion      = NULL;
                 pDiskThread  = NULL;
             }
@@ -45,7 +46,7 @@ namespace LinuxSampler {
             virtual R* GetRegion() { return pRegion; }
 
             virtual unsigned long GetSampleCacheSize() {
-                return pSample->GetCache().Size;
+                return StreamOnly ? 0 : pSample->GetCache().Size;
             }
 
             /**
@@ -73,14 +74,39 @@ namespace LinuxSampler {
                 this->pRegion = pRegion;
                 this->pSample = pRegion->pSample; // sample won't change until the voice is finished
 
-                return AbstractVoice::Trigger (
+                StreamOnly = false;
+                StreamWaitSamples = 0;
+                #if CONFIG_LAZY_SAMPLE_LOADING
+                // the sample's initial part isn't cached yet, so let the disk
+                // thread cache it for next time and play this voice from its
+                // disk stream only (GetCache() reads the size with acquire
+                // semantics, so the cached sample points are visible once
+                // it's not 0)
+                if (!pSample->GetCache().Size) {
+                    pDiskThread->OrderCachingOfRegion(pRegion);
+                    StreamOnly = true;
+                }
+                #endif
+
+                int res = AbstractVoice::Trigger (
                     pEngineChannel, itNoteOnEvent, PitchBend, VoiceType, iKeyGroup
                 );
+                if (!res && StreamOnly && DiskVoice) {
+                    // there's no RAM part to play, start with the disk stream
+                    PlaybackState = Voice::playback_state_disk;
+                }
+                return res;
             }
 
             virtual int OrderNewStream() {
+                unsigned long pos = MaxRAMPos + GetRAMCacheOffset();
+                if (StreamOnly) {
+                    // stream right from the playback start
+                    pos = RgnInfo.SampleStartOffset;
+                    finalSynthesisParameters.dPos = 0;
+                }
                 int res = pDiskThread->OrderNewStream (
-                    &DiskStreamRef, pRegion, MaxRAMPos + GetRAMCacheOffset(), !RAMLoop
+                    &DiskStreamRef, pRegion, pos, !RAMLoop
                 );
 
                 if (res < 0) {
@@ -135,6 +161,21 @@ namespace LinuxSampler {
                         break;
 
                     case Voice::playback_state_disk: {
+                            if (StreamOnly) {
+                                if (!StreamReady()) {
+                                    // wait silently (but process the voice's
+                                    // events) until the stream has data
+                                    StreamWaitSamples += Samples;
+                                    if (StreamWaitSamples > GetEngine()->SampleRate) {
+                                        std::cerr << "Disk stream not available in time!\n" << std::flush;
+                                        KillImmediately();
+                                        return;
+                                    }
+                                    Synthesize(Samples, NULL, Delay);
+                                    break;
+                                }
+                                StreamOnly = false; // playing from now on
+                            }
                             if (!DiskStreamRef.pStream) {
                                 // check if the disk thread created our ordered disk stream in the meantime
                                 DiskStreamRef.pStream = pDiskThread->AskForCreatedStream(DiskStreamRef.OrderID);
@@ -229,8 +270,25 @@ namespace LinuxSampler {
             }
 
         protected:
-            S*  pSample;   ///< Pointer to the sample to be played back
-            R*  pRegion;   ///< Pointer to the articulation information of current region of this voice
+            S*   pSample;           ///< Pointer to the sample to be played back
+            R*   pRegion;           ///< Pointer to the articulation information of current region of this voice
+            bool StreamOnly;        ///< The sample's initial part wasn't cached yet when the voice was triggered (see CONFIG_LAZY_SAMPLE_LOADING), so the voice is played from its disk stream only. Stays set while the voice waits silently for the stream's data.
+            uint StreamWaitSamples; ///< Sample points a StreamOnly voice waited for its disk stream so far.
+
+            /**
+             * Whether the disk stream of a StreamOnly voice was created and
+             * has enough data for a whole audio fragment (or reached its end).
+             */
+            bool StreamReady() {
+                if (!DiskStreamRef.pStream) {
+                    DiskStreamRef.pStream = pDiskThread->AskForCreatedStream(DiskStreamRef.OrderID);
+                    if (!DiskStreamRef.pStream) return false;
+                    RealSampleWordsLeftToRead = -1; // -1 means no silence has been added yet
+                }
+                const int maxSampleWordsPerCycle = (GetEngine()->MaxSamplesPerCycle << CONFIG_MAX_PITCH) * SmplInfo.ChannelCount + 6; // +6 for the interpolator algorithm
+                return DiskStreamRef.State == Stream::state_end ||
+                       DiskStreamRef.pStream->GetReadSpace() >= maxSampleWordsPerCycle;
+            }
 
             virtual MidiKeyBase* GetMidiKeyInfo(int MIDIKey) {
                 EC* pChannel = static_cast<EC*>(pEngineChannel);
@@ -44,8 +44,8 @@ namespace gig {
         ::gig::Sample::DestroyDecompressionBuffer(DecompressionBuffer);
     }
 
-    LinuxSampler::Stream* DiskThread::CreateStream(long BufferSize, uint BufferWrapElements) {
-        return new Stream(&DecompressionBuffer, (uint)BufferSize, BufferWrapElements); // 131072 sample words
+    LinuxSampler::Stream* DiskThread::CreateStream(long BufferSize, uint BufferWrapElements, uint8_t* pBufferMemory) {
+        return new Stream(&DecompressionBuffer, (uint)BufferSize, BufferWrapElements, pBufferMemory); // 131072 sample words
     }
 
     void DiskThread::LaunchStream (
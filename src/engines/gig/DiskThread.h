@@ -41,7 +41,7 @@ namespace LinuxSampler { namespace gig {
         protected:
             ::gig::buffer_t DecompressionBuffer; ///< Used for thread safe streaming.
 
-            virtual LinuxSampler::Stream* CreateStream(long BufferSize, uint BufferWrapElements);
+            virtual LinuxSampler::Stream* CreateStream(long BufferSize, uint BufferWrapElements, uint8_t* pBufferMemory);
 
             virtual void LaunchStream (
                 LinuxSampler::Stream*    pStream,
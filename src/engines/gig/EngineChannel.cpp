@@ -27,7 +27,10 @@
 #include "Engine.h"
 
 namespace LinuxSampler { namespace gig {
-    EngineChannel::EngineChannel() {
+    EngineChannel::EngineChannel() :
+        SharedLFOs(1.0f, ControllerTable),           // amplitude and cutoff LFOs (0..1 range)
+        SharedPitchLFOs(1200.0f, ControllerTable)    // pitch LFOs (-1200..+1200 range)
+    {
         CurrentGigScript = NULL;
     }
 
@@ -44,6 +47,16 @@ namespace LinuxSampler { namespace gig {
 
     AbstractEngine::Format EngineChannel::GetEngineFormat() { return AbstractEngine::GIG; }
 
+    void EngineChannel::Connect(AudioOutputDevice* pAudioOut) {
+        if (GetAudioOutputDevice() == pAudioOut) return;
+        // disconnect first, the shared LFOs must not be resized while our
+        // voices are rendered
+        if (pEngine) DisconnectAudioOutputDevice();
+        SharedLFOs.Resize(pAudioOut->MaxSamplesPerCycle());
+        SharedPitchLFOs.Resize(pAudioOut->MaxSamplesPerCycle());
+        EngineChannelBase<Voice, ::gig::DimensionRegion, ::gig::Instrument>::Connect(pAudioOut);
+    }
+
     /** This method is not thread safe! */
     void EngineChannel::ResetInternal(bool bResetEngine) {
         CurrentKeyDimension = 0;
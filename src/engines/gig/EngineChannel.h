@@ -29,6 +29,8 @@
 #include "../AbstractEngine.h"
 #include "../EngineChannelBase.h"
 #include "../EngineChannelFactory.h"
+#include "../common/AbstractVoice.h"
+#include "../common/SharedLFOBank.h"
 #include "Voice.h"
 
 #if AC_APPLE_UNIVERSAL_BUILD
@@ -50,6 +52,9 @@ namespace LinuxSampler { namespace gig {
 
             virtual AbstractEngine::Format GetEngineFormat() OVERRIDE;
 
+            using LinuxSampler::EngineChannelBase<Voice, ::gig::DimensionRegion, ::gig::Instrument>::Connect;
+            virtual void Connect(AudioOutputDevice* pAudioOut) OVERRIDE;
+
             void reloadScript(::gig::Script* script);
 
             friend class Voice;
@@ -62,6 +67,8 @@ namespace LinuxSampler { namespace gig {
 
             float CurrentKeyDimension;      ///< Current value (0-1.0) for the keyboard dimension, altered by pressing a keyswitching key.
             ::gig::Script* CurrentGigScript; ///< Only used when a script is updated (i.e. by instrument editor), to check whether this engine channel is actually using that specific script reference.
+            SharedLFOBank<LFOUnsigned> SharedLFOs;      ///< Amplitude and filter cutoff LFOs of all voices with "LFO sync" enabled.
+            SharedLFOBank<LFOSigned>   SharedPitchLFOs; ///< Pitch LFOs of all voices with "LFO sync" enabled.
 
             virtual void ProcessKeySwitchChange(int key) OVERRIDE;
 
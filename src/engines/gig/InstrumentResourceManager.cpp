@@ -683,8 +683,7 @@ namespace LinuxSampler { namespace gig {
      */
     void InstrumentResourceManager::CacheInitialSamples(::gig::Sample* pSample, AbstractEngine* pEngine) {
         uint maxSamplesPerCycle =
-            (pEngine) ? pEngine->pAudioOutputDevice->MaxSamplesPerCycle() :
-            DefaultMaxSamplesPerCycle();
+            GetMaxSamplesPerCycle((pEngine) ? pEngine->pAudioOutputDevice : NULL);
         CacheInitialSamples(pSample, maxSamplesPerCycle);
     }
 
@@ -695,7 +694,14 @@ namespace LinuxSampler { namespace gig {
         }
         if (!pSample->SamplesTotal) return; // skip zero size samples
 
-        if (pSample->SamplesTotal <= CONFIG_PRELOAD_SAMPLES) {
+        // Compressed samples up to CONFIG_PRELOAD_COMPRESSED_SAMPLES are
+        // decompressed completely into RAM as well, because decompressing
+        // them while streaming limits the disk thread's throughput.
+        const bool bLoadWhole =
+            pSample->SamplesTotal <= CONFIG_PRELOAD_SAMPLES ||
+            (pSample->Compressed && pSample->SamplesTotal <= CONFIG_PRELOAD_COMPRESSED_SAMPLES);
+
+        if (bLoadWhole) {
             // Sample is too short for disk streaming, so we load the whole
             // sample into RAM and place 'pAudioIO->FragmentSize << CONFIG_MAX_PITCH'
             // number of '0' samples (silence samples) behind the official buffer
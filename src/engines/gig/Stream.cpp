@@ -31,7 +31,8 @@ namespace LinuxSampler { namespace gig {
     Stream::Stream (
         ::gig::buffer_t* pDecompressionBuffer,
         uint             BufferSize,
-        uint             BufferWrapElements) : LinuxSampler::StreamBase< ::gig::DimensionRegion>(BufferSize, BufferWrapElements)
+        uint             BufferWrapElements,
+        uint8_t*         pBufferMemory) : LinuxSampler::StreamBase< ::gig::DimensionRegion>(BufferSize, BufferWrapElements, pBufferMemory)
     {
         this->pDecompressionBuffer = pDecompressionBuffer;
     }
@@ -40,7 +40,7 @@ namespace LinuxSampler { namespace gig {
             ::gig::buffer_t* pDecompressionBuffer;
 
         public:
-            Stream( ::gig::buffer_t* pDecompressionBuffer, uint BufferSize, uint BufferWrapElements);
+            Stream( ::gig::buffer_t* pDecompressionBuffer, uint BufferSize, uint BufferWrapElements, uint8_t* pBufferMemory = NULL);
             virtual long Read(uint8_t* pBuf, long SamplesToRead);
 
             void Launch (
@@ -22,6 +22,7 @@ namespace LinuxSampler { namespace gig {
         Filter    filterLeft;
         Filter    filterRight;
         float     fFinalPitch;
+        float     fFinalPitchDelta; ///< only used with CONFIG_INTERPOLATE_PITCH
         float     fFinalVolumeLeft;
         float     fFinalVolumeRight;
         float     fFinalVolumeDeltaLeft;
@@ -31,6 +31,11 @@
         Synthesizer<CHAN,LOOP,FILTER,INTERPOLATE,BITDEPTH24>::SynthesizeSubFragment(  \
         pFinalParam, pLoop)
 
+// same as above, with loops of CONFIG_DEFAULT_SUBFRAGMENT_SIZE fixed length
+#define SYNTHESIZE_FIXED(CHAN,LOOP,FILTER,INTERPOLATE,BITDEPTH24)                     \
+        Synthesizer<CHAN,LOOP,FILTER,INTERPOLATE,BITDEPTH24,CONFIG_DEFAULT_SUBFRAGMENT_SIZE>::SynthesizeSubFragment( \
+        pFinalParam, pLoop)
+
 namespace LinuxSampler { namespace gig {
 
     void SynthesizeFragment_mode00(SynthesisParam* pFinalParam, Loop* pLoop) {
@@ -161,8 +166,136 @@ namespace LinuxSampler { namespace gig {
         SYNTHESIZE(STEREO,1,1,1,1);
     }
 
+    void SynthesizeFragment_mode80(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE_FIXED(MONO,0,0,0,0);
+    }
+
+    void SynthesizeFragment_mode81(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE_FIXED(MONO,0,0,1,0);
+    }
+
+    void SynthesizeFragment_mode82(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE_FIXED(MONO,0,1,0,0);
+    }
+
+    void SynthesizeFragment_mode83(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE_FIXED(MONO,0,1,1,0);
+    }
+
+    void SynthesizeFragment_mode84(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE_FIXED(MONO,1,0,0,0);
+    }
+
+    void SynthesizeFragment_mode85(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE_FIXED(MONO,1,0,1,0);
+    }
+
+    void SynthesizeFragment_mode86(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE_FIXED(MONO,1,1,0,0);
+    }
+
+    void SynthesizeFragment_mode87(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE_FIXED(MONO,1,1,1,0);
+    }
+
+    void SynthesizeFragment_mode88(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE_FIXED(STEREO,0,0,0,0);
+    }
+
+    void SynthesizeFragment_mode89(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE_FIXED(STEREO,0,0,1,0);
+    }
+
+    void SynthesizeFragment_mode8a(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE_FIXED(STEREO,0,1,0,0);
+    }
+
+    void SynthesizeFragment_mode8b(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE_FIXED(STEREO,0,1,1,0);
+    }
+
+    void SynthesizeFragment_mode8c(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE_FIXED(STEREO,1,0,0,0);
+    }
+
+    void SynthesizeFragment_mode8d(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE_FIXED(STEREO,1,0,1,0);
+    }
+
+    void SynthesizeFragment_mode8e(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE_FIXED(STEREO,1,1,0,0);
+    }
+
+    void SynthesizeFragment_mode8f(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE_FIXED(STEREO,1,1,1,0);
+    }
+
+    void SynthesizeFragment_mode90(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE_FIXED(MONO,0,0,0,1);
+    }
+
+    void SynthesizeFragment_mode91(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE_FIXED(MONO,0,0,1,1);
+    }
+
+    void SynthesizeFragment_mode92(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE_FIXED(MONO,0,1,0,1);
+    }
+
+    void SynthesizeFragment_mode93(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE_FIXED(MONO,0,1,1,1);
+    }
+
+    void SynthesizeFragment_mode94(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE_FIXED(MONO,1,0,0,1);
+    }
+
+    void SynthesizeFragment_mode95(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE_FIXED(MONO,1,0,1,1);
+    }
+
+    void SynthesizeFragment_mode96(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE_FIXED(MONO,1,1,0,1);
+    }
+
+    void SynthesizeFragment_mode97(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE_FIXED(MONO,1,1,1,1);
+    }
+
+    void SynthesizeFragment_mode98(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE_FIXED(STEREO,0,0,0,1);
+    }
+
+    void SynthesizeFragment_mode99(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE_FIXED(STEREO,0,0,1,1);
+    }
+
+    void SynthesizeFragment_mode9a(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE_FIXED(STEREO,0,1,0,1);
+    }
+
+    void SynthesizeFragment_mode9b(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE_FIXED(STEREO,0,1,1,1);
+    }
+
+    void SynthesizeFragment_mode9c(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE_FIXED(STEREO,1,0,0,1);
+    }
+
+    void SynthesizeFragment_mode9d(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE_FIXED(STEREO,1,0,1,1);
+    }
+
+    void SynthesizeFragment_mode9e(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE_FIXED(STEREO,1,1,0,1);
+    }
+
+    void SynthesizeFragment_mode9f(SynthesisParam* pFinalParam, Loop* pLoop) {
+        SYNTHESIZE_FIXED(STEREO,1,1,1,1);
+    }
+
     void* GetSynthesisFunction(int SynthesisMode) {
-        // Mode Bits: (PROF),(IMPL),24BIT,CHAN,LOOP,FILT,INTERP
+        // Mode Bits: FIXEDSIZE,(PROF),(IMPL),24BIT,CHAN,LOOP,FILT,INTERP
         switch (SynthesisMode) {
             case 0x00: return (void*) SynthesizeFragment_mode00;
             case 0x01: return (void*) SynthesizeFragment_mode01;
@@ -196,6 +329,38 @@ namespace LinuxSampler { namespace gig {
             case 0x1d: return (void*) SynthesizeFragment_mode1d;
             case 0x1e: return (void*) SynthesizeFragment_mode1e;
             case 0x1f: return (void*) SynthesizeFragment_mode1f;
+            case 0x80: return (void*) SynthesizeFragment_mode80;
+            case 0x81: return (void*) SynthesizeFragment_mode81;
+            case 0x82: return (void*) SynthesizeFragment_mode82;
+            case 0x83: return (void*) SynthesizeFragment_mode83;
+            case 0x84: return (void*) SynthesizeFragment_mode84;
+            case 0x85: return (void*) SynthesizeFragment_mode85;
+            case 0x86: return (void*) SynthesizeFragment_mode86;
+            case 0x87: return (void*) SynthesizeFragment_mode87;
+            case 0x88: return (void*) SynthesizeFragment_mode88;
+            case 0x89: return (void*) SynthesizeFragment_mode89;
+            case 0x8a: return (void*) SynthesizeFragment_mode8a;
+            case 0x8b: return (void*) SynthesizeFragment_mode8b;
+            case 0x8c: return (void*) SynthesizeFragment_mode8c;
+            case 0x8d: return (void*) SynthesizeFragment_mode8d;
+            case 0x8e: return (void*) SynthesizeFragment_mode8e;
+            case 0x8f: return (void*) SynthesizeFragment_mode8f;
+            case 0x90: return (void*) SynthesizeFragment_mode90;
+            case 0x91: return (void*) SynthesizeFragment_mode91;
+            case 0x92: return (void*) SynthesizeFragment_mode92;
+            case 0x93: return (void*) SynthesizeFragment_mode93;
+            case 0x94: return (void*) SynthesizeFragment_mode94;
+            case 0x95: return (void*) SynthesizeFragment_mode95;
+            case 0x96: return (void*) SynthesizeFragment_mode96;
+            case 0x97: return (void*) SynthesizeFragment_mode97;
+            case 0x98: return (void*) SynthesizeFragment_mode98;
+            case 0x99: return (void*) SynthesizeFragment_mode99;
+            case 0x9a: return (void*) SynthesizeFragment_mode9a;
+            case 0x9b: return (void*) SynthesizeFragment_mode9b;
+            case 0x9c: return (void*) SynthesizeFragment_mode9c;
+            case 0x9d: return (void*) SynthesizeFragment_mode9d;
+            case 0x9e: return (void*) SynthesizeFragment_mode9e;
+            case 0x9f: return (void*) SynthesizeFragment_mode9f;
             default: {
                 std::cerr << "gig::Synthesizer: Invalid Synthesis Mode: " << SynthesisMode << std::endl << std::flush;
                 exit(-1);
@@ -208,4 +373,19 @@ namespace LinuxSampler { namespace gig {
         f(pFinalParam, pLoop);
     }
 
+    void RunAdvanceFunction(const int SynthesisMode, SynthesisParam* pFinalParam, Loop* pLoop) {
+        // only looping and interpolation affect the playback position
+        if (SYNTHESIS_MODE_GET_LOOP(SynthesisMode)) {
+            if (SYNTHESIS_MODE_GET_INTERPOLATE(SynthesisMode))
+                Synthesizer<MONO,1,0,1,0>::AdvanceSubFragment(pFinalParam, pLoop);
+            else
+                Synthesizer<MONO,1,0,0,0>::AdvanceSubFragment(pFinalParam, pLoop);
+        } else {
+            if (SYNTHESIS_MODE_GET_INTERPOLATE(SynthesisMode))
+                Synthesizer<MONO,0,0,1,0>::AdvanceSubFragment(pFinalParam, pLoop);
+            else
+                Synthesizer<MONO,0,0,0,0>::AdvanceSubFragment(pFinalParam, pLoop);
+        }
+    }
+
 }} // namespace LinuxSampler::gig
@@ -39,6 +39,7 @@
 #define SYNTHESIS_MODE_SET_IMPLEMENTATION(iMode,bVal)   { if (bVal) iMode |= 0x20; else iMode &= ~0x20; }   /* (un)set mode bit 5 */
 //TODO: the profiling mode is currently not implemented anymore!
 #define SYNTHESIS_MODE_SET_PROFILING(iMode,bVal)        { if (bVal) iMode |= 0x40; else iMode &= ~0x40; }   /* (un)set mode bit 6 */
+#define SYNTHESIS_MODE_SET_FIXEDSIZE(iMode,bVal)        { if (bVal) iMode |= 0x80; else iMode &= ~0x80; }   /* (un)set mode bit 7 */
 
 #define SYNTHESIS_MODE_GET_INTERPOLATE(iMode)           (iMode & 0x01)
 #define SYNTHESIS_MODE_GET_FILTER(iMode)                (iMode & 0x02)
@@ -46,6 +47,7 @@
 #define SYNTHESIS_MODE_GET_CHANNELS(iMode)              (iMode & 0x08)
 #define SYNTHESIS_MODE_GET_BITDEPTH24(iMode)            (iMode & 0x10)
 #define SYNTHESIS_MODE_GET_IMPLEMENTATION(iMode)        (iMode & 0x20)
+#define SYNTHESIS_MODE_GET_FIXEDSIZE(iMode)             (iMode & 0x80)
 
 
 namespace LinuxSampler { namespace gig {
@@ -54,6 +56,7 @@ namespace LinuxSampler { namespace gig {
 
     void* GetSynthesisFunction(const int SynthesisMode);
     void RunSynthesisFunction(const int SynthesisMode, SynthesisParam* pFinalParam, Loop* pLoop);
+    void RunAdvanceFunction(const int SynthesisMode, SynthesisParam* pFinalParam, Loop* pLoop);
 
     enum channels_t {
         MONO,
@@ -65,8 +68,15 @@ namespace LinuxSampler { namespace gig {
      * Implementation of the main synthesis algorithms of the Gigasampler
      * format capable sampler engine. This means resampling / interpolation
      * for pitching the audio signal, looping, filter and amplification.
+     *
+     * If @a FIXEDSIZE is not zero, the synthesis loops of this class have a
+     * compile time constant length of @a FIXEDSIZE sample points whenever a
+     * whole subfragment of that size can be rendered in one go, which lets
+     * the compiler unroll and vectorize them. Shorter parts (i.e. at loop
+     * boundaries) are rendered by the generic implementation
+     * (@a FIXEDSIZE = 0) instead.
      */
-    template<channels_t CHANNELS, bool DOLOOP, bool USEFILTER, bool INTERPOLATE, bool BITDEPTH24>
+    template<channels_t CHANNELS, bool DOLOOP, bool USEFILTER, bool INTERPOLATE, bool BITDEPTH24, uint FIXEDSIZE = 0>
     class Synthesizer : public __RTMath<CPP>, public LinuxSampler::Resampler<INTERPOLATE,BITDEPTH24> {
 
             // declarations of derived functions (see "Name lookup,
@@ -82,6 +92,21 @@ namespace LinuxSampler { namespace gig {
         //protected:
 
             static void SynthesizeSubFragment(SynthesisParam* pFinalParam, Loop* pLoop) {
+                ProcessSubFragment<true>(pFinalParam, pLoop);
+            }
+
+            /**
+             * Does not render anything, but advances the playback position
+             * (including looping), the volume and the output pointers
+             * exactly like SynthesizeSubFragment() would. This is used for
+             * voices which are currently inaudible.
+             */
+            static void AdvanceSubFragment(SynthesisParam* pFinalParam, Loop* pLoop) {
+                ProcessSubFragment<false>(pFinalParam, pLoop);
+            }
+
+            template<bool RENDER>
+            static void ProcessSubFragment(SynthesisParam* pFinalParam, Loop* pLoop) {
                 if (DOLOOP) {
                     const float fLoopEnd   = Float(pLoop->uiEnd);
                     const float fLoopStart = Float(pLoop->uiStart);
@@ -89,20 +114,75 @@ namespace LinuxSampler { namespace gig {
                     if (pLoop->uiTotalCycles) {
                         // render loop (loop count limited)
                         for (; pFinalParam->uiToGo > 0 && pLoop->uiCyclesLeft; pLoop->uiCyclesLeft -= WrapLoop(fLoopStart, fLoopSize, fLoopEnd, &pFinalParam->dPos)) {
-                            const uint uiToGo = Min(pFinalParam->uiToGo, DiffToLoopEnd(fLoopEnd, &pFinalParam->dPos, pFinalParam->fFinalPitch) + 1); //TODO: instead of +1 we could also round up
-                            SynthesizeSubSubFragment(pFinalParam, uiToGo);
+                            const uint uiToGo = Min(pFinalParam->uiToGo, DiffToLoopEnd(fLoopEnd, &pFinalParam->dPos, MaxPitch(pFinalParam)) + 1); //TODO: instead of +1 we could also round up
+                            ProcessChunk<RENDER>(pFinalParam, uiToGo);
                         }
                         // render on without loop
-                        SynthesizeSubSubFragment(pFinalParam, pFinalParam->uiToGo);
+                        ProcessChunk<RENDER>(pFinalParam, pFinalParam->uiToGo);
                     } else { // render loop (endless loop)
                         for (; pFinalParam->uiToGo > 0; WrapLoop(fLoopStart, fLoopSize, fLoopEnd, &pFinalParam->dPos)) {
-                            const uint uiToGo = Min(pFinalParam->uiToGo, DiffToLoopEnd(fLoopEnd, &pFinalParam->dPos, pFinalParam->fFinalPitch) + 1); //TODO: instead of +1 we could also round up
-                            SynthesizeSubSubFragment(pFinalParam, uiToGo);
+                            const uint uiToGo = Min(pFinalParam->uiToGo, DiffToLoopEnd(fLoopEnd, &pFinalParam->dPos, MaxPitch(pFinalParam)) + 1); //TODO: instead of +1 we could also round up
+                            ProcessChunk<RENDER>(pFinalParam, uiToGo);
                         }
                     }
                 } else { // no looping
-                    SynthesizeSubSubFragment(pFinalParam, pFinalParam->uiToGo);
+                    ProcessChunk<RENDER>(pFinalParam, pFinalParam->uiToGo);
+                }
+            }
+
+            template<bool RENDER>
+            inline static void ProcessChunk(SynthesisParam* pFinalParam, uint uiToGo) {
+                if (RENDER) SynthesizeChunk(pFinalParam, uiToGo);
+                else        AdvanceChunk(pFinalParam, uiToGo);
+            }
+
+            /**
+             * Renders the given amount of sample points, with the fixed size
+             * loops if possible, with the generic ones otherwise.
+             */
+            inline static void SynthesizeChunk(SynthesisParam* pFinalParam, uint uiToGo) {
+                if (!FIXEDSIZE || uiToGo == FIXEDSIZE)
+                    SynthesizeSubSubFragment(pFinalParam, uiToGo);
+                else
+                    Synthesizer<CHANNELS,DOLOOP,USEFILTER,INTERPOLATE,BITDEPTH24,0>::SynthesizeSubSubFragment(pFinalParam, uiToGo);
+            }
+
+            /**
+             * Advances the synthesis parameters by the given amount of
+             * sample points without rendering anything.
+             */
+            static void AdvanceChunk(SynthesisParam* pFinalParam, uint uiToGo) {
+                if (!uiToGo) return;
+                if (INTERPOLATE) {
+#ifdef CONFIG_INTERPOLATE_PITCH
+                    pFinalParam->dPos += uiToGo * (pFinalParam->fFinalPitch + 0.5 * (uiToGo - 1) * pFinalParam->fFinalPitchDelta);
+                    pFinalParam->fFinalPitch += uiToGo * pFinalParam->fFinalPitchDelta;
+#else
+                    pFinalParam->dPos += uiToGo * pFinalParam->fFinalPitch;
+#endif
+                } else {
+                    pFinalParam->dPos += uiToGo;
                 }
+#ifdef CONFIG_INTERPOLATE_VOLUME
+                pFinalParam->fFinalVolumeLeft  += uiToGo * pFinalParam->fFinalVolumeDeltaLeft;
+                pFinalParam->fFinalVolumeRight += uiToGo * pFinalParam->fFinalVolumeDeltaRight;
+#endif
+                pFinalParam->pOutRight += uiToGo;
+                pFinalParam->pOutLeft  += uiToGo;
+                pFinalParam->uiToGo    -= uiToGo;
+            }
+
+            /**
+             * Returns the highest pitch used while rendering the rest of the
+             * current subfragment.
+             */
+            inline static float MaxPitch(const SynthesisParam* pFinalParam) {
+#ifdef CONFIG_INTERPOLATE_PITCH
+                return Max(pFinalParam->fFinalPitch,
+                           pFinalParam->fFinalPitch + pFinalParam->fFinalPitchDelta * pFinalParam->uiToGo);
+#else
+                return pFinalParam->fFinalPitch;
+#endif
             }
 
             /**
@@ -153,6 +233,7 @@ namespace LinuxSampler { namespace gig {
             }
 
             static void SynthesizeSubSubFragment(SynthesisParam* pFinalParam, uint uiToGo) {
+                if (FIXEDSIZE) uiToGo = FIXEDSIZE; // compile time constant loop length
                 float fVolumeL = pFinalParam->fFinalVolumeLeft;
                 float fVolumeR = pFinalParam->fFinalVolumeRight;
                 sample_t* pSrc = pFinalParam->pSrc;
@@ -168,10 +249,16 @@ namespace LinuxSampler { namespace gig {
                         if (INTERPOLATE) {
                             double dPos    = pFinalParam->dPos;
                             float fPitch   = pFinalParam->fFinalPitch;
+#ifdef CONFIG_INTERPOLATE_PITCH
+                            float fPitchDelta = pFinalParam->fFinalPitchDelta;
+#endif
                             if (USEFILTER) {
                                 Filter& filterL = pFinalParam->filterLeft;
                                 for (int i = 0; i < uiToGo; ++i) {
                                     samplePoint = Interpolate1StepMonoCPP(pSrc, &dPos, fPitch);
+#ifdef CONFIG_INTERPOLATE_PITCH
+                                    fPitch += fPitchDelta;
+#endif
                                     samplePoint = filterL.Apply(samplePoint);
 #ifdef CONFIG_INTERPOLATE_VOLUME
                                     fVolumeL += fDeltaL;
@@ -183,6 +270,9 @@ namespace LinuxSampler { namespace gig {
                             } else { // no filter needed
                                 for (int i = 0; i < uiToGo; ++i) {
                                     samplePoint = Interpolate1StepMonoCPP(pSrc, &dPos, fPitch);
+#ifdef CONFIG_INTERPOLATE_PITCH
+                                    fPitch += fPitchDelta;
+#endif
 #ifdef CONFIG_INTERPOLATE_VOLUME
                                     fVolumeL += fDeltaL;
                                     fVolumeR += fDeltaR;
@@ -192,6 +282,7 @@ namespace LinuxSampler { namespace gig {
                                 }
                             }
                             pFinalParam->dPos = dPos;
+                            pFinalParam->fFinalPitch = fPitch;
                         } else { // no interpolation
                             int pos_offset = (int) pFinalParam->dPos;
                             if (USEFILTER) {
@@ -226,11 +317,17 @@ namespace LinuxSampler { namespace gig {
                         if (INTERPOLATE) {
                             double dPos    = pFinalParam->dPos;
                             float fPitch   = pFinalParam->fFinalPitch;
+#ifdef CONFIG_INTERPOLATE_PITCH
+                            float fPitchDelta = pFinalParam->fFinalPitchDelta;
+#endif
                             if (USEFILTER) {
                                 Filter& filterL = pFinalParam->filterLeft;
                                 Filter& filterR = pFinalParam->filterRight;
                                 for (int i = 0; i < uiToGo; ++i) {
                                     samplePoint = Interpolate1StepStereoCPP(pSrc, &dPos, fPitch);
+#ifdef CONFIG_INTERPOLATE_PITCH
+                                    fPitch += fPitchDelta;
+#endif
                                     samplePoint.left  = filterL.Apply(samplePoint.left);
                                     samplePoint.right = filterR.Apply(samplePoint.right);
 #ifdef CONFIG_INTERPOLATE_VOLUME
@@ -243,6 +340,9 @@ namespace LinuxSampler { namespace gig {
                             } else { // no filter needed
                                 for (int i = 0; i < uiToGo; ++i) {
                                     samplePoint = Interpolate1StepStereoCPP(pSrc, &dPos, fPitch);
+#ifdef CONFIG_INTERPOLATE_PITCH
+                                    fPitch += fPitchDelta;
+#endif
 #ifdef CONFIG_INTERPOLATE_VOLUME
                                     fVolumeL += fDeltaL;
                                     fVolumeR += fDeltaR;
@@ -252,6 +352,7 @@ namespace LinuxSampler { namespace gig {
                                 }
                             }
                             pFinalParam->dPos = dPos;
+                            pFinalParam->fFinalPitch = fPitch;
                         } else { // no interpolation
                             int pos_offset = ((int) pFinalParam->dPos) << 1;
                             if (USEFILTER) {
@@ -37,6 +37,7 @@ namespace LinuxSampler { namespace gig {
         pEngine = NULL;
         pEG1 = &EG1;
         pEG2 = &EG2;
+        iSharedLFO1 = iSharedLFO2 = iSharedLFO3 = -1;
     }
 
     Voice::~Voice() {
@@ -239,6 +240,46 @@ namespace LinuxSampler { namespace gig {
         return eg;
     }
 
+    /**
+     * Returns the shared LFO of the engine channel with the given settings,
+     * for LFOs which have "LFO sync" enabled and thus run in phase for all
+     * voices of the engine channel. The voice's own LFO @a pLFO (already
+     * triggered by the caller) is used instead if the bank is full.
+     *
+     * @returns index of the shared LFO, -1 if none is available
+     */
+    template<class LFO>
+    int Voice::AcquireSharedLFO(SharedLFOBank<LFO>& bank, LFO* pLFO, float Frequency, start_level_t StartLevel, uint16_t InternalDepth, uint16_t ExtControlDepth, bool FlipPhase) {
+        typename SharedLFOBank<LFO>::params_t params;
+        params.Frequency       = Frequency;
+        params.StartLevel      = StartLevel;
+        params.InternalDepth   = InternalDepth;
+        params.ExtControlDepth = ExtControlDepth;
+        params.FlipPhase       = FlipPhase;
+        params.ExtController   = pLFO->ExtController;
+        params.SampleRate      = pEngine->SampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE;
+        return bank.Acquire(params);
+    }
+
+    void Voice::PrepareSharedLFOs(uint Samples) {
+        EngineChannel* pChannel = GetGigEngineChannel();
+        pSharedLFO1Levels = (iSharedLFO1 < 0) ? NULL :
+            pChannel->SharedLFOs.Levels(iSharedLFO1, pEngine->FrameTime, Samples);
+        pSharedLFO2Levels = (iSharedLFO2 < 0) ? NULL :
+            pChannel->SharedLFOs.Levels(iSharedLFO2, pEngine->FrameTime, Samples);
+        pSharedLFO3Levels = (iSharedLFO3 < 0) ? NULL :
+            pChannel->SharedPitchLFOs.Levels(iSharedLFO3, pEngine->FrameTime, Samples);
+    }
+
+    void Voice::VoiceFreed() {
+        EngineChannel* pChannel = GetGigEngineChannel();
+        pChannel->SharedLFOs.Release(iSharedLFO1);
+        pChannel->SharedLFOs.Release(iSharedLFO2);
+        pChannel->SharedPitchLFOs.Release(iSharedLFO3);
+        iSharedLFO1 = iSharedLFO2 = iSharedLFO3 = -1;
+        pSharedLFO1Levels = pSharedLFO2Levels = pSharedLFO3Levels = NULL;
+    }
+
     void Voice::InitLFO1() {
         uint16_t lfo1_internal_depth;
         switch (pRegion->LFO1Controller) {
@@ -280,6 +321,12 @@ namespace LinuxSampler { namespace gig {
                            pRegion->LFO1FlipPhase,
                            pEngine->SampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
             pLFO1->update(pLFO1->ExtController ? GetGigEngineChannel()->ControllerTable[pLFO1->ExtController] : 0);
+            if (pRegion->LFO1Sync) {
+                iSharedLFO1 = AcquireSharedLFO(
+                    GetGigEngineChannel()->SharedLFOs, pLFO1, pRegion->LFO1Frequency,
+                    start_level_min, lfo1_internal_depth, pRegion->LFO1ControlDepth, pRegion->LFO1FlipPhase
+                );
+            }
         }
     }
 
@@ -324,6 +371,12 @@ namespace LinuxSampler { namespace gig {
                            pRegion->LFO2FlipPhase,
                            pEngine->SampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
             pLFO2->update(pLFO2->ExtController ? GetGigEngineChannel()->ControllerTable[pLFO2->ExtController] : 0);
+            if (pRegion->LFO2Sync) {
+                iSharedLFO2 = AcquireSharedLFO(
+                    GetGigEngineChannel()->SharedLFOs, pLFO2, pRegion->LFO2Frequency,
+                    start_level_max, lfo2_internal_depth, pRegion->LFO2ControlDepth, pRegion->LFO2FlipPhase
+                );
+            }
         }
     }
 
@@ -368,6 +421,12 @@ namespace LinuxSampler { namespace gig {
                            false,
                            pEngine->SampleRate / CONFIG_DEFAULT_SUBFRAGMENT_SIZE);
             pLFO3->update(pLFO3->ExtController ? GetGigEngineChannel()->ControllerTable[pLFO3->ExtController] : 0);
+            if (pRegion->LFO3Sync) {
+                iSharedLFO3 = AcquireSharedLFO(
+                    GetGigEngineChannel()->SharedPitchLFOs, pLFO3, pRegion->LFO3Frequency,
+                    start_level_mid, lfo3_internal_depth, pRegion->LFO3ControlDepth, false
+                );
+            }
         }
     }
 
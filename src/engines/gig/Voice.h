@@ -78,6 +78,8 @@ namespace LinuxSampler { namespace gig {
             virtual void             InitLFO1() OVERRIDE;
             virtual void             InitLFO2() OVERRIDE;
             virtual void             InitLFO3() OVERRIDE;
+            virtual void             PrepareSharedLFOs(uint Samples) OVERRIDE;
+            virtual void             VoiceFreed() OVERRIDE;
             virtual float            CalculateCutoffBase(uint8_t MIDIKeyVelocity) OVERRIDE;
             virtual float            CalculateFinalCutoff(float cutoffBase) OVERRIDE;
             virtual uint8_t          GetVCFCutoffCtrl() OVERRIDE;
@@ -95,6 +97,12 @@ namespace LinuxSampler { namespace gig {
         private:
             EGADSR EG1;
             EGADSR EG2;
+            int    iSharedLFO1; ///< Index of LFO 1 in the engine channel's SharedLFOs bank, -1 if pLFO1 is used.
+            int    iSharedLFO2; ///< Index of LFO 2 in the engine channel's SharedLFOs bank, -1 if pLFO2 is used.
+            int    iSharedLFO3; ///< Index of LFO 3 in the engine channel's SharedPitchLFOs bank, -1 if pLFO3 is used.
+
+            template<class LFO>
+            int AcquireSharedLFO(SharedLFOBank<LFO>& bank, LFO* pLFO, float Frequency, start_level_t StartLevel, uint16_t InternalDepth, uint16_t ExtControlDepth, bool FlipPhase);
 
         public: // FIXME: just made public for debugging (sanity check in Engine::RenderAudio()), should be changed to private before the final release
             // Attributes
@@ -43,8 +43,8 @@ namespace sf2 {
         
     }
 
-    LinuxSampler::Stream* DiskThread::CreateStream(long BufferSize, uint BufferWrapElements) {
-        return new Stream((uint)BufferSize, BufferWrapElements); // 131072 sample words
+    LinuxSampler::Stream* DiskThread::CreateStream(long BufferSize, uint BufferWrapElements, uint8_t* pBufferMemory) {
+        return new Stream((uint)BufferSize, BufferWrapElements, pBufferMemory); // 131072 sample words
     }
 
     void DiskThread::LaunchStream (
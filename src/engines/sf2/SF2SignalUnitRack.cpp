@@ -221,6 +221,11 @@ namespace LinuxSampler { namespace sf2 {
                ::sf2::ToRatio(prmModLfoVol->GetValue() /*logarithmically modified */);
     }
     
+    float EndpointUnit::GetEnvelopeVolume() {
+        if (!prmVolEg->pUnit->Active()) return 0;
+        return prmVolEg->GetValue();
+    }
+    
     float EndpointUnit::GetFilterCutoff() {
         double modEg, modLfo;
         modEg = prmModEgCutoff->pUnit->Active() ? prmModEgCutoff->GetValue() : 0;
@@ -99,6 +99,7 @@ namespace LinuxSampler { namespace sf2 {
             virtual bool Active() OVERRIDE;
             
             virtual float GetVolume() OVERRIDE;
+            virtual float GetEnvelopeVolume() OVERRIDE;
             virtual float GetFilterCutoff() OVERRIDE;
             virtual float GetPitch() OVERRIDE;
             virtual float GetResonance() OVERRIDE;
@@ -32,8 +32,9 @@ namespace LinuxSampler { namespace sf2 {
 
     Stream::Stream (
         uint BufferSize,
-        uint BufferWrapElements
-    ) : LinuxSampler::StreamBase< ::sf2::Region>(BufferSize, BufferWrapElements) {
+        uint BufferWrapElements,
+        uint8_t* pBufferMemory
+    ) : LinuxSampler::StreamBase< ::sf2::Region>(BufferSize, BufferWrapElements, pBufferMemory) {
         
     }
 
@@ -37,7 +37,7 @@ namespace LinuxSampler { namespace sf2 {
 
     class Stream: public LinuxSampler::StreamBase< ::sf2::Region> {
         public:
-            Stream(uint BufferSize, uint BufferWrapElements);
+            Stream(uint BufferSize, uint BufferWrapElements, uint8_t* pBufferMemory = NULL);
             virtual long Read(uint8_t* pBuf, long SamplesToRead);
             virtual void Kill();
 
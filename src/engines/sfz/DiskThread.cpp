@@ -43,8 +43,8 @@ namespace sfz {
         
     }
 
-    LinuxSampler::Stream* DiskThread::CreateStream(long BufferSize, uint BufferWrapElements) {
-        return new Stream((uint)BufferSize, BufferWrapElements, pInstruments->GetSampleManager()); // 131072 sample words
+    LinuxSampler::Stream* DiskThread::CreateStream(long BufferSize, uint BufferWrapElements, uint8_t* pBufferMemory) {
+        return new Stream((uint)BufferSize, BufferWrapElements, pInstruments->GetSampleManager(), pBufferMemory); // 131072 sample words
     }
 
     void DiskThread::LaunchStream (
@@ -33,7 +33,7 @@ namespace LinuxSampler { namespace sfz {
 
     class DiskThread: public LinuxSampler::DiskThreadBase< ::sfz::Region, InstrumentResourceManager> {
         protected:
-            virtual LinuxSampler::Stream* CreateStream(long BufferSize, uint BufferWrapElements);
+            virtual LinuxSampler::Stream* CreateStream(long BufferSize, uint BufferWrapElements, uint8_t* pBufferMemory);
 
             virtual void LaunchStream (
                 LinuxSampler::Stream*  pStream,
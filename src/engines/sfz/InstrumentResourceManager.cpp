@@ -23,6 +23,7 @@
  ***************************************************************************/
 
 #include <sstream>
+#include <algorithm>
 
 #include "InstrumentResourceManager.h"
 #include "EngineChannel.h"
@@ -32,6 +33,14 @@
 #include "../../common/Path.h"
 #include "../../plugins/InstrumentEditorFactory.h"
 
+// With lazy sample loading, regions up to this amount of keys away from a
+// region triggered for the first time are cached along with it ...
+#define LAZY_WARMUP_KEYS        2
+// ... but at most this amount of them per triggered region ...
+#define LAZY_WARMUP_REGIONS     32
+// ... and at most this amount of them are pending at any time (the oldest
+// ones are dropped).
+#define LAZY_WARMUP_PENDING     (4 * LAZY_WARMUP_REGIONS)
 
 namespace LinuxSampler { namespace sfz {
 
@@ -109,16 +118,28 @@ namespace LinuxSampler { namespace sfz {
         }
         dmsg(1,("OK\n"));
 
-        // cache initial samples points (for actually needed samples)
-        dmsg(1,("Caching initial samples..."));
         int regionCount = (int) pInstrument->regions.size();
         uint maxSamplesPerCycle = GetMaxSamplesPerCycle(pConsumer);
+#if CONFIG_LAZY_SAMPLE_LOADING
+        // only read the sample headers, the initial sample points are cached
+        // by the disk thread when a region is triggered (see CacheRegion())
+        dmsg(1,("Reading sample headers..."));
+        for (int i = 0 ; i < regionCount ; i++) {
+            float localProgress = (float) i / (float) regionCount;
+            DispatchResourceProgressEvent(Key, localProgress);
+            pInstrument->regions[i]->GetSample();
+        }
+        AddLazyInstrument(pInstrument, maxSamplesPerCycle);
+#else
+        // cache initial samples points (for actually needed samples)
+        dmsg(1,("Caching initial samples..."));
         for (int i = 0 ; i < regionCount ; i++) {
             float localProgress = (float) i / (float) regionCount;
             DispatchResourceProgressEvent(Key, localProgress);
             CacheInitialSamples(pInstrument->regions[i]->GetSample(), maxSamplesPerCycle);
             //pInstrument->regions[i]->GetSample()->Close();
         }
+#endif
         dmsg(1,("OK\n"));
         DispatchResourceProgressEvent(Key, 1.0f); // done; notify all consumers about progress 100%
 
@@ -138,11 +159,109 @@ namespace LinuxSampler { namespace sfz {
 
     void InstrumentResourceManager::Destroy(::sfz::Instrument* pResource, void* pArg) {
         instr_entry_t* pEntry = (instr_entry_t*) pArg;
+#if CONFIG_LAZY_SAMPLE_LOADING
+        RemoveLazyInstrument(pResource);
+#endif
         // we don't need the .sfz file here anymore
         Sfzs.HandBack(pEntry->pFile, reinterpret_cast<SfzConsumer*>(pEntry->ID.Index)); // conversion kinda hackish :/
         delete pEntry;
     }
 
+    void InstrumentResourceManager::AddLazyInstrument(::sfz::Instrument* pInstrument, uint maxSamplesPerCycle) {
+        LockGuard lock(LazyMutex);
+        LazyInstruments[pInstrument] = maxSamplesPerCycle;
+        LazyRegions.insert(LazyRegions.end(), pInstrument->regions.begin(), pInstrument->regions.end());
+        std::sort(LazyRegions.begin(), LazyRegions.end());
+    }
+
+    void InstrumentResourceManager::RemoveLazyInstrument(::sfz::Instrument* pInstrument) {
+        LockGuard lock(LazyMutex);
+        if (!LazyInstruments.erase(pInstrument)) return;
+        std::vector< ::sfz::Region*> regions = pInstrument->regions;
+        std::sort(regions.begin(), regions.end());
+        size_t n = 0;
+        for (size_t i = 0; i < LazyRegions.size(); i++) {
+            if (!std::binary_search(regions.begin(), regions.end(), LazyRegions[i]))
+                LazyRegions[n++] = LazyRegions[i];
+        }
+        LazyRegions.resize(n);
+        n = 0;
+        for (size_t i = 0; i < WarmupRegions.size(); i++) {
+            if (!std::binary_search(regions.begin(), regions.end(), WarmupRegions[i]))
+                WarmupRegions[n++] = WarmupRegions[i];
+        }
+        WarmupRegions.resize(n);
+    }
+
+    /**
+     * Caches the initial sample points of the given sample on the disk
+     * thread, which must not be left by an exception if there's not enough
+     * memory for the cache.
+     */
+    void InstrumentResourceManager::CacheSampleLazily(Sample* pSample, uint maxSamplesPerCycle) {
+        try {
+            CacheInitialSamples(pSample, maxSamplesPerCycle);
+        } catch (Exception& e) {
+            e.PrintMessage();
+        }
+    }
+
+    /**
+     * Caches the initial sample points of the given region's sample and
+     * schedules the samples of the regions of the same articulation on the
+     * same and neighboring keys (i.e. other velocity layers and round
+     * robins) for caching, since those are likely to be triggered soon as
+     * well. Those are cached by CacheNextScheduledSample() afterwards, one
+     * per disk thread iteration. Called by the disk thread after a region
+     * was triggered whose sample wasn't cached yet (see
+     * CONFIG_LAZY_SAMPLE_LOADING).
+     */
+    void InstrumentResourceManager::CacheRegion(::sfz::Region* pRegion) {
+        LockGuard lock(LazyMutex);
+        // the region's instrument might have been unloaded meanwhile
+        if (!std::binary_search(LazyRegions.begin(), LazyRegions.end(), pRegion)) return;
+        if (pRegion->pSample->GetCache().Size) return; // was ordered more than once
+
+        ::sfz::Instrument* pInstrument = pRegion->GetInstrument();
+        const uint maxSamplesPerCycle = LazyInstruments[pInstrument];
+        dmsg(2,("Lazily caching sample '%s'\n", pRegion->pSample->GetName().c_str()));
+        CacheSampleLazily(pRegion->pSample, maxSamplesPerCycle);
+
+        // collect the uncached neighbors with their distance in keys
+        std::vector< std::pair<int,int> > neighbors;
+        for (int i = 0; i < (int) pInstrument->regions.size(); i++) {
+            ::sfz::Region* pRgn = pInstrument->regions[i];
+            if (!pRgn->pSample || pRgn->pSample->GetCache().Size) continue;
+            if (pRgn->sw_last != pRegion->sw_last || pRgn->sw_down != pRegion->sw_down ||
+                pRgn->sw_up != pRegion->sw_up || pRgn->sw_previous != pRegion->sw_previous) continue;
+            const int distance = std::max(0, std::max(pRgn->lokey - pRegion->hikey, pRegion->lokey - pRgn->hikey));
+            if (distance > LAZY_WARMUP_KEYS) continue;
+            neighbors.push_back(std::make_pair(distance, i));
+        }
+        std::sort(neighbors.begin(), neighbors.end());
+
+        const int n = std::min((int) neighbors.size(), LAZY_WARMUP_REGIONS);
+        for (int i = n - 1; i >= 0; i--)
+            WarmupRegions.push_front(pInstrument->regions[neighbors[i].second]);
+        if (WarmupRegions.size() > LAZY_WARMUP_PENDING)
+            WarmupRegions.resize(LAZY_WARMUP_PENDING);
+    }
+
+    bool InstrumentResourceManager::CacheNextScheduledSample() {
+        LockGuard lock(LazyMutex);
+        while (!WarmupRegions.empty()) {
+            ::sfz::Region* pRegion = WarmupRegions.front();
+            WarmupRegions.pop_front();
+            // regions might share a sample
+            if (pRegion->pSample->GetCache().Size) continue;
+            const uint maxSamplesPerCycle = LazyInstruments[pRegion->GetInstrument()];
+            dmsg(3,("Warming up sample '%s'\n", pRegion->pSample->GetName().c_str()));
+            CacheSampleLazily(pRegion->pSample, maxSamplesPerCycle);
+            return true;
+        }
+        return false;
+    }
+
     void InstrumentResourceManager::DeleteRegionIfNotUsed(::sfz::Region* pRegion, region_info_t* pRegInfo) {
         ::sfz::File* file = pRegInfo->file;
         if (file == NULL) return;
@@ -158,6 +277,16 @@ namespace LinuxSampler { namespace sfz {
         
     }
 
+    bool InstrumentResourceManager::IsSampleCachedCompletely(Sample* pSample) {
+        // Compressed (FLAC / Ogg Vorbis) samples up to
+        // CONFIG_PRELOAD_COMPRESSED_SAMPLES are decoded completely into RAM
+        // as well, because decoding them while streaming is CPU bound.
+        const long frames = pSample->GetTotalFrameCount();
+        return frames <= CONFIG_PRELOAD_SAMPLES ||
+               (static_cast< ::sfz::Sample*>(pSample)->IsCompressed() &&
+                frames <= CONFIG_PRELOAD_COMPRESSED_SAMPLES);
+    }
+
 
 
     // internal sfz file manager
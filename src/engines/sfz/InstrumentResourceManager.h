@@ -37,6 +37,8 @@
 #include "../common/Sample.h"
 #include "../../common/ArrayList.h"
 
+#include <deque>
+
 namespace LinuxSampler { namespace sfz {
 
     typedef ResourceConsumer< ::sfz::Instrument> InstrumentConsumer;
@@ -72,15 +74,28 @@ namespace LinuxSampler { namespace sfz {
 
             ::sfz::SampleManager* GetSampleManager() { return &Sfzs.sampleManager; }
 
+            virtual void CacheRegion(::sfz::Region* pRegion);
+            virtual bool CacheNextScheduledSample();
+
         protected:
             // implementation of derived abstract methods from 'ResourceManager'
             virtual ::sfz::Instrument* Create(instrument_id_t Key, InstrumentConsumer* pConsumer, void*& pArg);
             virtual void               Destroy(::sfz::Instrument* pResource, void* pArg);
             virtual void               DeleteRegionIfNotUsed(::sfz::Region* pRegion, region_info_t* pRegInfo);
             virtual void               DeleteSampleIfNotUsed(Sample* pSample, region_info_t* pRegInfo);
+            virtual bool               IsSampleCachedCompletely(Sample* pSample);
         private:
             typedef ResourceConsumer< ::sfz::File> SfzConsumer;
 
+            Mutex LazyMutex; ///< Protects LazyInstruments, LazyRegions and WarmupRegions, locked while the disk thread caches samples.
+            std::map< ::sfz::Instrument*, uint> LazyInstruments; ///< Loaded instruments whose samples are cached lazily, with the max. samples per cycle they were loaded for.
+            std::vector< ::sfz::Region*> LazyRegions; ///< Regions of all LazyInstruments (sorted), to check whether a region ordered for caching still exists.
+            std::deque< ::sfz::Region*> WarmupRegions; ///< Neighbors of lazily cached regions, whose samples are cached one per disk thread iteration (most recently scheduled first).
+
+            void AddLazyInstrument(::sfz::Instrument* pInstrument, uint maxSamplesPerCycle);
+            void RemoveLazyInstrument(::sfz::Instrument* pInstrument);
+            void CacheSampleLazily(Sample* pSample, uint maxSamplesPerCycle);
+
             class SfzResourceManager : public ResourceManager<String, ::sfz::File> {
                 protected:
                     // implementation of derived abstract methods from 'ResourceManager'
@@ -267,7 +267,9 @@ namespace LinuxSampler { namespace sfz {
     }
 
     void LFOUnit::Increment() {
-        if (DelayStage()) return;
+        // the amp, pitch and filter LFOs are part of every rack, but
+        // are only rendered if the region actually uses them
+        if (!Active() || DelayStage()) return;
         
         SignalUnit::Increment();
         
@@ -613,7 +615,7 @@ namespace LinuxSampler { namespace sfz {
         return b;
     }
     
-    float EndpointUnit::GetVolume() {
+    float EndpointUnit::GetEnvelopeVolume() {
         float vol = GetRack()->suVolEG.Active() ? GetRack()->suVolEG.GetLevel() : 0;
         
         for (int i = 0; i < GetRack()->volEGs.size(); i++) {
@@ -635,13 +637,21 @@ namespace LinuxSampler { namespace sfz {
             vol += amp * eg->GetLevel();
         }
         
+        vol *= ToRatio(GetRack()->suVolOnCC.GetLevel() * 10.0);
+        
+        if (suXFInCC.Active())  vol *= suXFInCC.GetLevel();
+        if (suXFOutCC.Active()) vol *= suXFOutCC.GetLevel();
+        return vol * xfCoeff;
+    }
+    
+    float EndpointUnit::GetVolume() {
+        float vol = GetEnvelopeVolume();
+        
         AmpLFOUnit* u = &(GetRack()->suAmpLFO);
         CCSignalUnit* u2 = &(GetRack()->suAmpLFO.suDepthOnCC);
         float f = u2->Active() ? u2->GetLevel() : 0;
         vol *= u->Active() ? ToRatio((u->GetLevel() * (u->pLfoInfo->volume + f) * 10.0)) : 1;
         
-        vol *= ToRatio(GetRack()->suVolOnCC.GetLevel() * 10.0);
-        
         for (int i = 0; i < GetRack()->volLFOs.size(); i++) {
             LFOv2Unit* lfo = GetRack()->volLFOs[i];
             if (!lfo->Active()) continue;
@@ -650,9 +660,7 @@ namespace LinuxSampler { namespace sfz {
             vol *= ToRatio(lfo->GetLevel() * (lfo->pLfoInfo->volume + f) * 10.0);
         }
         
-        if (suXFInCC.Active())  vol *= suXFInCC.GetLevel();
-        if (suXFOutCC.Active()) vol *= suXFOutCC.GetLevel();
-        return vol * xfCoeff;
+        return vol;
     }
     
     float EndpointUnit::GetFilterCutoff() {
@@ -386,6 +386,7 @@ namespace LinuxSampler { namespace sfz {
             virtual bool Active();
             
             virtual float GetVolume();
+            virtual float GetEnvelopeVolume();
             virtual float GetFilterCutoff();
             virtual float GetPitch();
             virtual float GetResonance();
@@ -33,8 +33,9 @@ namespace LinuxSampler { namespace sfz {
     Stream::Stream (
         uint BufferSize,
         uint BufferWrapElements,
-        ::sfz::SampleManager* pSampleManager
-    ) : LinuxSampler::StreamBase< ::sfz::Region>(BufferSize, BufferWrapElements) {
+        ::sfz::SampleManager* pSampleManager,
+        uint8_t* pBufferMemory
+    ) : LinuxSampler::StreamBase< ::sfz::Region>(BufferSize, BufferWrapElements, pBufferMemory) {
         this->pSampleManager = pSampleManager;
     }
 
@@ -51,17 +52,14 @@ namespace LinuxSampler { namespace sfz {
         }
         else { // normal forward playback
 
-            pSample->SetPos(this->SampleOffset); // recover old position
-
+            // we have to read from the position stored in this stream, because other streams might use the same sample
             do {
-                readsamples        = pSample->Read(&pBuf[total_readsamples * pSample->GetFrameSize()], SamplesToRead);
+                readsamples        = pSample->ReadAt(this->SampleOffset, &pBuf[total_readsamples * pSample->GetFrameSize()], SamplesToRead);
                 SamplesToRead     -= readsamples;
                 total_readsamples += readsamples;
+                this->SampleOffset += readsamples;
             } while (SamplesToRead && readsamples > 0);
 
-            // we have to store the position within the sample, because other streams might use the same sample
-            this->SampleOffset = pSample->GetPos();
-
             endofsamplereached = (SampleOffset >= pSample->GetTotalFrameCount());
             dmsg(5,("Refilled stream %d with %ld (SamplePos: %lu)", this->hThis, total_readsamples, this->SampleOffset));
         }
@@ -73,6 +71,11 @@ namespace LinuxSampler { namespace sfz {
         return total_readsamples;
     }
 
+    bool Stream::IsCompressed() {
+        ::sfz::Region* pRgn = pRegion; // might be reset by the audio thread meanwhile
+        return pRgn && pRgn->pSample && pRgn->pSample->IsCompressed();
+    }
+
     void Stream::Kill() {
         if(pRegion) pSampleManager->SetSampleNotInUse(pRegion->pSample, pRegion);
         StreamBase< ::sfz::Region>::Kill();
@@ -32,9 +32,10 @@ namespace LinuxSampler { namespace sfz {
 
     class Stream: public LinuxSampler::StreamBase< ::sfz::Region> {
         public:
-            Stream(uint BufferSize, uint BufferWrapElements, ::sfz::SampleManager* pSampleManager);
+            Stream(uint BufferSize, uint BufferWrapElements, ::sfz::SampleManager* pSampleManager, uint8_t* pBufferMemory = NULL);
             virtual long Read(uint8_t* pBuf, long SamplesToRead);
             virtual void Kill();
+            virtual bool IsCompressed();
 
             void Launch (
                 Stream::Handle  hStream,
@@ -52,20 +52,35 @@ namespace sfz
     }
 
     Sample* SampleManager::FindSample(std::string samplePath, uint offset, int end) {
-        std::map<Sample*, std::set<Region*> >::iterator it = sampleMap.begin();
-        for (; it != sampleMap.end(); it++) {
-            if (it->first->GetFile() == samplePath) {
+        LinuxSampler::LockGuard lock(SamplesMutex);
+        LinuxSampler::SmallSet<Sample>* pSamples = samplesByFile.find(LinuxSampler::HashOf(samplePath));
+        if (!pSamples) return NULL;
+        for (size_t i = 0; i < pSamples->size(); i++) {
+            Sample* pSample = (*pSamples)[i];
+            if (pSample->GetFile() == samplePath) {
                 /* Because the start of the sample is cached in RAM we treat
                  * same sample with different offset as different samples
                  * // TODO: Ignore offset when the whole sample is cached in RAM?
                  */
-                if (it->first->Offset == offset && it->first->End == end) return it->first;
+                if (pSample->Offset == offset && pSample->End == end) return pSample;
             }
         }
 
         return NULL;
     }
 
+    void SampleManager::OnSampleAdded(Sample* pSample) {
+        samplesByFile[LinuxSampler::HashOf(pSample->GetFile())].insert(pSample);
+    }
+
+    void SampleManager::OnSampleRemoved(Sample* pSample) {
+        const size_t hash = LinuxSampler::HashOf(pSample->GetFile());
+        LinuxSampler::SmallSet<Sample>* pSamples = samplesByFile.find(hash);
+        if (!pSamples) return;
+        pSamples->erase(pSample);
+        if (pSamples->empty()) samplesByFile.erase(hash);
+    }
+
     /////////////////////////////////////////////////////////////
     // class Script
 
@@ -26,6 +26,8 @@
 
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <set>
 #include <vector>
 #include <stack>
 #include <string>
@@ -152,13 +154,25 @@ namespace sfz
         Sample* FindSample(std::string samplePath, uint offset, int end);
 
     protected:
+        // Samples which are not in use anymore are not closed explicitly,
+        // they are closed by the pool of open sample files when room for
+        // other files is needed (see LinuxSampler::SampleFile). This is
+        // called by the disk thread, so a file that can't be opened is only
+        // reported here (reading from it just returns no data).
         virtual void OnSampleInUse(Sample* pSample) {
-            pSample->Open();
+            try {
+                pSample->Open();
+            } catch (LinuxSampler::Exception& e) {
+                e.PrintMessage();
+            }
         }
 
-        virtual void OnSampleInNotUse(Sample* pSample) {
-            pSample->Close();
-        }
+        virtual void OnSampleAdded(Sample* pSample);
+        virtual void OnSampleRemoved(Sample* pSample);
+
+    private:
+        /// Samples by the hash of their file name, so that FindSample() doesn't have to compare the file names of all samples.
+        LinuxSampler::HashMap<size_t, LinuxSampler::SmallSet<Sample> > samplesByFile;
     };
     
     class CC {
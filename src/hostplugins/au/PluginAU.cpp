@@ -207,6 +207,7 @@ COMPONENT_ENTRY(PluginAU)
         }
 
         Init(srate, GetMaxFramesPerSlice(), chnNum);
+        PropertyChanged(kAudioUnitProperty_Latency, kAudioUnitScope_Global, 0);
 
         if(hostName.empty()) {
             hostName = GetHostNameByID(GetHostBundleID());
@@ -243,6 +244,12 @@ COMPONENT_ENTRY(PluginAU)
 	return noErr;
     }
 
+    Float64 PluginAU::GetLatency() {
+        // delay added by rendering in fixed size blocks, if any
+        if (!pAudioDevice) return 0;
+        return Float64(pAudioDevice->RenderLatency()) / pAudioDevice->SampleRate();
+    }
+
     bool PluginAU::StreamFormatWritable(AudioUnitScope scope, AudioUnitElement element) {
         return IsInitialized() ? false : true;
     }
@@ -43,6 +43,7 @@ using namespace LinuxSampler;
             virtual UInt32    SupportedNumChannels(const AUChannelInfo** outInfo);
             virtual bool      StreamFormatWritable(AudioUnitScope scope, AudioUnitElement element);
             virtual ComponentResult Initialize();
+            virtual Float64   GetLatency();
 
             virtual ComponentResult GetPropertyInfo (
                 AudioUnitPropertyID  inID,
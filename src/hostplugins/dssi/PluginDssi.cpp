@@ -47,6 +47,7 @@ namespace {
     PluginInstance::PluginInstance(unsigned long SampleRate) {
         Out[0] = 0;
         Out[1] = 0;
+        LatencyOut = 0;
 
         if (!plugin) {
             plugin = new PluginDssi(SampleRate);
@@ -106,6 +107,7 @@ namespace {
 
     void PluginInstance::ConnectPort(unsigned long Port, LADSPA_Data* DataLocation) {
         if (Port < 2) Out[Port] = DataLocation;
+        else if (Port == 2) LatencyOut = DataLocation;
     }
 
     char* PluginInstance::Configure(const char* Key, const char* Value) {
@@ -149,6 +151,12 @@ namespace {
         unsigned eventPosArr[InstanceCount];
         for (unsigned long i = 0 ; i < InstanceCount ; i++) eventPosArr[i] = 0;
 
+        // delay added by rendering in fixed size blocks, if any
+        for (unsigned long i = 0 ; i < InstanceCount ; i++) {
+            PluginInstance* instance = static_cast<PluginInstance*>(Instances[i]);
+            if (instance->LatencyOut) *instance->LatencyOut = audioDevice->RenderLatency();
+        }
+
         int samplePos = 0;
         while (SampleCount) {
             int samples = std::min(SampleCount, 128UL);
@@ -274,7 +282,7 @@ namespace {
         Ladspa.Maker = "linuxsampler.org";
         Ladspa.Copyright = "(C) 2003,2004 Benno Senoner and Christian Schoenebeck, "
             "2005-2013 Christian Schoenebeck";
-        Ladspa.PortCount = 2;
+        Ladspa.PortCount = 3;
         Ladspa.ImplementationData = 0;
         Ladspa.PortDescriptors = PortDescriptors;
         Ladspa.PortRangeHints = PortRangeHints;
@@ -286,6 +294,11 @@ namespace {
         PortDescriptors[1] = LADSPA_PORT_OUTPUT | LADSPA_PORT_AUDIO;
         PortNames[1] = "Output Right";
         PortRangeHints[1].HintDescriptor = 0;
+        // hosts recognize an output control port named "latency" as the
+        // plugin's latency in sample points
+        PortDescriptors[2] = LADSPA_PORT_OUTPUT | LADSPA_PORT_CONTROL;
+        PortNames[2] = "latency";
+        PortRangeHints[2].HintDescriptor = LADSPA_HINT_INTEGER;
 
         Ladspa.activate = activate;
         Ladspa.cleanup = cleanup;
@@ -56,6 +56,7 @@ namespace {
         LinuxSampler::AudioChannel* pChannelRight;
 
         LADSPA_Data* Out[2];
+        LADSPA_Data* LatencyOut;
     };
 
     class PluginInfo {
@@ -69,9 +70,9 @@ namespace {
     private:
         LADSPA_Descriptor Ladspa;
         DSSI_Descriptor Dssi;
-        LADSPA_PortDescriptor PortDescriptors[2];
-        LADSPA_PortRangeHint PortRangeHints[2];
-        const char* PortNames[2];
+        LADSPA_PortDescriptor PortDescriptors[3];
+        LADSPA_PortRangeHint PortRangeHints[3];
+        const char* PortNames[3];
 
         PluginInfo();
         static PluginInfo Instance;
@@ -37,6 +37,7 @@
 #define NS_LS   "http://linuxsampler.org/schema#"
 
 #define CHANNELS 32
+#define MAX_FRAGMENT 128
 
 namespace {
 
@@ -47,9 +48,16 @@ namespace {
         for (int i = 0 ; i < CHANNELS ; i++) {
             Out[i] = 0;
         }
+        // all output buses but the first one are optional, so a host
+        // may use the plugin as simple stereo instrument as well
+        UnusedOut = new float[MAX_FRAGMENT];
+        ProgressOut = 0;
+        LatencyOut = 0;
         UriMap = 0;
         MapPath = 0;
         MakePath = 0;
+        Schedule = 0;
+        RestoreSchedule = 0;
         for (int i = 0 ; Features[i] ; i++) {
             dmsg(2, ("linuxsampler: init feature: %s\n", Features[i]->URI));
             if (!strcmp(Features[i]->URI, LV2_URID__map)) {
@@ -58,12 +66,23 @@ namespace {
                 MapPath = (LV2_State_Map_Path*)Features[i]->data;
             } else if (!strcmp(Features[i]->URI, LV2_STATE__makePath)) {
                 MakePath = (LV2_State_Make_Path*)Features[i]->data;
+            } else if (!strcmp(Features[i]->URI, LV2_WORKER__schedule)) {
+                Schedule = (LV2_Worker_Schedule*)Features[i]->data;
             }
         }
 
+        PendingRequest = 0;
+        RestoreRequested.store(0);
+        RestoreApplied = 0;
+        bRestoreLoading = false;
+        bPollPending = false;
+        Progress = 100;
+        SamplesSincePoll = 0;
+        PollInterval = uint32_t(SampleRate / 10); // 100 ms
+
         MidiEventType = uri_to_id(LV2_MIDI__MidiEvent);
 
-        Init(SampleRate, 128, CHANNELS);
+        Init(SampleRate, MAX_FRAGMENT, CHANNELS);
 
         InitState();
 
@@ -72,6 +91,7 @@ namespace {
 
     PluginLv2::~PluginLv2() {
         delete[] Out;
+        delete[] UnusedOut;
     }
 
     void PluginLv2::ConnectPort(uint32_t Port, void* DataLocation) {
@@ -79,6 +99,10 @@ namespace {
             MidiBuf = static_cast<LV2_Atom_Sequence*>(DataLocation);
         } else if (Port < CHANNELS + 1) {
             Out[Port - 1] = static_cast<float*>(DataLocation);
+        } else if (Port == CHANNELS + 1) {
+            ProgressOut = static_cast<float*>(DataLocation);
+        } else if (Port == CHANNELS + 2) {
+            LatencyOut = static_cast<float*>(DataLocation);
         }
     }
 
@@ -87,12 +111,43 @@ namespace {
     }
 
     void PluginLv2::Run(uint32_t SampleCount) {
+        const bool restoring =
+            RestoreApplied != RestoreRequested.load(LinuxSampler::memory_order_acquire);
+
+        // let the worker thread check the instrument loading progress
+        // from time to time, as long as restored instruments are loading
+        if (bRestoreLoading && !bPollPending) {
+            SamplesSincePoll += SampleCount;
+            if (SamplesSincePoll >= PollInterval) {
+                WorkerMessage msg;
+                msg.Type  = WorkerMessage::POLL_PROGRESS;
+                msg.Value = 0;
+                if (Schedule->schedule_work(Schedule->handle, sizeof(msg), &msg) ==
+                    LV2_WORKER_SUCCESS) {
+                    bPollPending = true;
+                    SamplesSincePoll = 0;
+                }
+            }
+        }
+        if (ProgressOut) *ProgressOut = restoring ? 0 : Progress;
+        // delay added by rendering in fixed size blocks, if any
+        if (LatencyOut) *LatencyOut = pAudioDevice->RenderLatency();
+
+        if (restoring || bRestoreLoading) {
+            // a restored state is being applied or its instruments are
+            // still being loaded in the background, so stay silent
+            for (int i = 0 ; i < CHANNELS ; i++) {
+                if (Out[i]) memset(Out[i], 0, SampleCount * sizeof(float));
+            }
+            return;
+        }
+
         int samplePos = 0;
 
         LV2_Atom_Event* ev = lv2_atom_sequence_begin(&MidiBuf->body);
 
         while (SampleCount) {
-            int samples = std::min(SampleCount, 128U);
+            int samples = std::min(SampleCount, uint32_t(MAX_FRAGMENT));
 
             for ( ; !lv2_atom_sequence_is_end(&MidiBuf->body,
                                               MidiBuf->atom.size, ev) ;
@@ -108,7 +163,9 @@ namespace {
                 }
             }
             for (int i = 0 ; i < CHANNELS ; i++) {
-                pAudioDevice->Channel(i)->SetBuffer(Out[i] + samplePos);
+                pAudioDevice->Channel(i)->SetBuffer(
+                    Out[i] ? Out[i] + samplePos : UnusedOut
+                );
             }
             pAudioDevice->Render(samples);
 
@@ -218,6 +275,46 @@ namespace {
         return LV2_STATE_SUCCESS;
     }
 
+    /*
+      Applies the given state text. If the host provided the LV2
+      worker feature to restore(), the state is only stored here and
+      applied later by the worker thread, so restore() returns
+      immediately. The plugin outputs silence until the state is
+      applied and its instruments are loaded. The file names are
+      mapped here already, as the path features passed to restore()
+      are not valid anymore when the worker runs.
+    */
+    void PluginLv2::RestoreState(const String& State) {
+        if (!RestoreSchedule) {
+            SetState(State);
+            return;
+        }
+
+        const int request = RestoreRequested.load(LinuxSampler::memory_order_relaxed) + 1;
+        {
+            LinuxSampler::LockGuard lock(PendingStateMutex);
+            PendingState = ResolveStatePaths(State);
+            PendingRequest = request;
+        }
+        RestoreRequested.store(request, LinuxSampler::memory_order_release);
+
+        WorkerMessage msg;
+        msg.Type  = WorkerMessage::RESTORE_STATE;
+        msg.Value = request;
+        if (RestoreSchedule->schedule_work(RestoreSchedule->handle, sizeof(msg), &msg) !=
+            LV2_WORKER_SUCCESS) {
+            // could not defer, so fall back to the blocking restore
+            dmsg(1, ("linuxsampler: could not schedule state restore\n"));
+            String state;
+            {
+                LinuxSampler::LockGuard lock(PendingStateMutex);
+                state.swap(PendingState);
+            }
+            SetState(state, false);
+            RestoreRequested.store(request - 1, LinuxSampler::memory_order_release);
+        }
+    }
+
     LV2_State_Status PluginLv2::Restore(
         LV2_State_Retrieve_Function retrieve, LV2_State_Handle handle,
         uint32_t rflags, const LV2_Feature* const* features)
@@ -226,6 +323,15 @@ namespace {
         LV2_State_Make_Path* OldMakePath = MakePath;
         SetStateFeatures(features);
 
+        // the worker feature passed to restore() (if any) may be used
+        // to apply the state asynchronously
+        RestoreSchedule = 0;
+        for (int i = 0 ; features && features[i] ; i++) {
+            if (!strcmp(features[i]->URI, LV2_WORKER__schedule)) {
+                RestoreSchedule = (LV2_Worker_Schedule*)features[i]->data;
+            }
+        }
+
         size_t   size;
         uint32_t type;
         uint32_t flags;
@@ -242,7 +348,7 @@ namespace {
             std::ifstream in(path.c_str());
             String state;
             std::getline(in, state, '\0');
-            SetState(state);
+            RestoreState(state);
         } else if ((value = retrieve(handle,
                                      uri_to_id(NS_LS "state-string"),
                                      &size, &type, &flags))) {
@@ -250,19 +356,84 @@ namespace {
             dmsg(2, ("linuxsampler: restoring from string\n"));
             assert(type == uri_to_id(LV2_ATOM__String));
             String state((const char*)value);
-            SetState(state);
+            RestoreState(state);
         } else {
             // No valid state found, reset to default state
             dmsg(2, ("linuxsampler: restoring default state\n"));
-            SetState(DefaultState);
+            RestoreState(DefaultState);
         }
 
         MapPath  = OldMapPath;
         MakePath = OldMakePath;
+        RestoreSchedule = 0;
 
         return LV2_STATE_SUCCESS;
     }
 
+    LV2_Worker_Status PluginLv2::Work(
+        LV2_Worker_Respond_Function respond, LV2_Worker_Respond_Handle handle,
+        uint32_t size, const void* data)
+    {
+        if (size != sizeof(WorkerMessage)) return LV2_WORKER_ERR_UNKNOWN;
+        const WorkerMessage* msg = static_cast<const WorkerMessage*>(data);
+
+        WorkerMessage reply;
+        reply.Type = WorkerMessage::PROGRESS;
+
+        switch (msg->Type) {
+            case WorkerMessage::RESTORE_STATE: {
+                String state;
+                int request;
+                {
+                    LinuxSampler::LockGuard lock(PendingStateMutex);
+                    state.swap(PendingState);
+                    request = PendingRequest;
+                }
+                // already applied together with an earlier message, as
+                // only the latest state is kept
+                if (state.empty()) return LV2_WORKER_SUCCESS;
+
+                dmsg(2, ("linuxsampler: applying restored state in worker\n"));
+                SetState(state, false);
+                reply.Type  = WorkerMessage::RESTORED;
+                reply.Value = request;
+                break;
+            }
+            case WorkerMessage::POLL_PROGRESS:
+                reply.Value = GetLoadingProgress();
+                break;
+            default:
+                return LV2_WORKER_ERR_UNKNOWN;
+        }
+        return respond(handle, sizeof(reply), &reply);
+    }
+
+    LV2_Worker_Status PluginLv2::WorkResponse(uint32_t size, const void* body) {
+        if (size != sizeof(WorkerMessage)) return LV2_WORKER_ERR_UNKNOWN;
+        const WorkerMessage* msg = static_cast<const WorkerMessage*>(body);
+
+        switch (msg->Type) {
+            case WorkerMessage::RESTORED:
+                RestoreApplied = msg->Value;
+                // without the run-time worker feature we could not poll
+                // the progress, so don't wait for the instruments then
+                bRestoreLoading = Schedule != 0;
+                Progress = bRestoreLoading ? 0 : 100;
+                SamplesSincePoll = PollInterval; // poll with the next run()
+                break;
+            case WorkerMessage::PROGRESS:
+                bPollPending = false;
+                // ignore replies computed before the state was applied
+                if (RestoreApplied != RestoreRequested.load(LinuxSampler::memory_order_acquire)) break;
+                Progress = msg->Value;
+                if (Progress >= 100) bRestoreLoading = false;
+                break;
+            default:
+                return LV2_WORKER_ERR_UNKNOWN;
+        }
+        return LV2_WORKER_SUCCESS;
+    }
+
     LV2_Handle instantiate(const LV2_Descriptor* descriptor,
                            double sample_rate, const char* bundle_path,
                            const LV2_Feature* const* features) {
@@ -303,6 +474,19 @@ namespace {
             retrieve, state, flags, features);
     }
 
+    LV2_Worker_Status work(LV2_Handle handle,
+                           LV2_Worker_Respond_Function respond,
+                           LV2_Worker_Respond_Handle respond_handle,
+                           uint32_t size, const void* data) {
+        return static_cast<PluginLv2*>(handle)->Work(
+            respond, respond_handle, size, data);
+    }
+
+    LV2_Worker_Status work_response(LV2_Handle handle,
+                                    uint32_t size, const void* body) {
+        return static_cast<PluginLv2*>(handle)->WorkResponse(size, body);
+    }
+
     PluginInfo PluginInfo::Instance;
 
     PluginInfo::PluginInfo() {
@@ -316,6 +500,9 @@ namespace {
         Lv2.extension_data = extension_data;
         StateInterface.save = save;
         StateInterface.restore = restore;
+        WorkerInterface.work = work;
+        WorkerInterface.work_response = work_response;
+        WorkerInterface.end_run = 0;
     }
 
 
@@ -323,6 +510,8 @@ namespace {
         dmsg(2, ("linuxsampler: extension_data %s\n", uri));
         if (strcmp(uri, LV2_STATE__interface) == 0) {
             return PluginInfo::Lv2StateInterface();
+        } else if (strcmp(uri, LV2_WORKER__interface) == 0) {
+            return PluginInfo::Lv2WorkerInterface();
         }
         return 0;
     }
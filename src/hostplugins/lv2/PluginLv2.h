@@ -22,11 +22,14 @@
 #define LS_PLUGINLV2_H
 
 #include "../../drivers/Plugin.h"
+#include "../../common/Mutex.h"
+#include "../../common/lsatomic.h"
 
 #include <lv2/lv2plug.in/ns/lv2core/lv2.h>
 #include <lv2/lv2plug.in/ns/ext/atom/atom.h>
 #include <lv2/lv2plug.in/ns/ext/state/state.h>
 #include <lv2/lv2plug.in/ns/ext/urid/urid.h>
+#include <lv2/lv2plug.in/ns/ext/worker/worker.h>
 
 namespace {
 
@@ -44,6 +47,10 @@ namespace {
                               uint32_t flags, const LV2_Feature* const* features);
         LV2_State_Status Restore(LV2_State_Retrieve_Function retrieve, void* data,
                                  uint32_t flags, const LV2_Feature* const* features);
+        LV2_Worker_Status Work(LV2_Worker_Respond_Function respond,
+                               LV2_Worker_Respond_Handle handle,
+                               uint32_t size, const void* data);
+        LV2_Worker_Status WorkResponse(uint32_t size, const void* body);
 
     protected:
         virtual String PathToState(const String& string);
@@ -55,15 +62,43 @@ namespace {
         }
 
         void SetStateFeatures(const LV2_Feature* const* Features);
+        void RestoreState(const String& State);
+
+        /// Messages passed between run() and the host's worker thread.
+        struct WorkerMessage {
+            enum type_t {
+                RESTORE_STATE,   ///< apply PendingState (worker thread)
+                POLL_PROGRESS,   ///< query instrument loading progress (worker thread)
+                RESTORED,        ///< restore request Value was applied (audio thread)
+                PROGRESS         ///< progress reply with Value (audio thread)
+            } Type;
+            int Value;
+        };
 
         float** Out;
+        float* UnusedOut; ///< render buffer for output ports not connected by the host
+        float* ProgressOut;
+        float* LatencyOut;
         LV2_Atom_Sequence* MidiBuf;
         LV2_URID_Map* UriMap;
         LV2_URID MidiEventType;
         LV2_State_Map_Path* MapPath;
         LV2_State_Make_Path* MakePath;
+        LV2_Worker_Schedule* Schedule;        ///< worker feature for use in run()
+        LV2_Worker_Schedule* RestoreSchedule; ///< worker feature passed to restore()
 
         String DefaultState;
+
+        String PendingState; ///< state text waiting to be applied by the worker
+        int PendingRequest;  ///< restore request number of PendingState
+        LinuxSampler::Mutex PendingStateMutex;
+        LinuxSampler::atomic<int> RestoreRequested; ///< number of the latest restore request
+        int RestoreApplied;   ///< number of the latest restore applied by the worker (audio thread only)
+        bool bRestoreLoading; ///< output silence until the restored instruments are loaded (audio thread only)
+        bool bPollPending;    ///< a POLL_PROGRESS request is in flight (audio thread only)
+        int Progress;         ///< last known loading progress in percent (audio thread only)
+        uint32_t SamplesSincePoll;
+        uint32_t PollInterval;
     };
 
     class PluginInfo {
@@ -74,9 +109,13 @@ namespace {
         static const LV2_State_Interface* Lv2StateInterface() {
             return &Instance.StateInterface;
         }
+        static const LV2_Worker_Interface* Lv2WorkerInterface() {
+            return &Instance.WorkerInterface;
+        }
     private:
         LV2_Descriptor Lv2;
         LV2_State_Interface StateInterface;
+        LV2_Worker_Interface WorkerInterface;
 
         PluginInfo();
         static PluginInfo Instance;
@@ -103,6 +142,14 @@ namespace {
                                         LV2_State_Retrieve_Function retrieve,
                                         LV2_State_Handle state, uint32_t flags,
                                         const LV2_Feature* const* features);
+
+        static LV2_Worker_Status work(LV2_Handle handle,
+                                      LV2_Worker_Respond_Function respond,
+                                      LV2_Worker_Respond_Handle respond_handle,
+                                      uint32_t size, const void* data);
+
+        static LV2_Worker_Status work_response(LV2_Handle handle,
+                                               uint32_t size, const void* body);
     }
 }
 
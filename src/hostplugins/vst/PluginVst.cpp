@@ -292,6 +292,8 @@ namespace {
             } else {
                 Init(int(sampleRate), blockSize, CHANNELS);
             }
+            // delay added by rendering in fixed size blocks, if any
+            setInitialDelay(pAudioDevice->RenderLatency());
         }
         AudioEffectX::resume();
         dmsg(2, ("<--resume\n"));
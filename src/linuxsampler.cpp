@@ -47,6 +47,7 @@
 #include "common/stacktrace.h"
 #include "common/Features.h"
 #include "common/atomic.h"
+#include "common/Thread.h"
 
 using namespace LinuxSampler;
 
@@ -351,6 +352,7 @@ void parse_options(int argc, char **argv) {
             {"lscp-port",required_argument,0,0},
             {"stacktrace",no_argument,0,0},
             {"exec-after-init",required_argument,0,0},
+            {"cpu-affinity",required_argument,0,0},
             {0,0,0,0}
         };
 
@@ -377,6 +379,8 @@ void parse_options(int argc, char **argv) {
                     printf("--stacktrace                automatically shows stacktrace if crashes\n");
                     printf("                            (broken on most systems at the moment)\n");
                     printf("--exec-after-init           executes a command after initialization\n");
+                    printf("--cpu-affinity ROLE=CPUS    pins threads of a role (AUDIO, MIDI, DISK,\n");
+                    printf("                            LOADER, LSCP) to the given CPUs (i.e. 2,4-7)\n");
                     exit(EXIT_SUCCESS);
                     break;
                 case 1: // --version
@@ -473,6 +477,18 @@ void parse_options(int argc, char **argv) {
                 case 10: // --exec-after-init
                     ExecAfterInit = optarg;
                     break;
+                case 11: { // --cpu-affinity
+                    const String arg = optarg;
+                    const String::size_type pos = arg.find('=');
+                    Thread::role_t role;
+                    std::vector<int> cpus;
+                    if (pos == String::npos ||
+                        !Thread::RoleByName(arg.substr(0, pos), role) ||
+                        !Thread::ParseCpuList(arg.substr(pos + 1), cpus) ||
+                        !Thread::SetCpuAffinity(role, cpus))
+                        printf("WARNING: Failed to parse cpu-affinity argument, ignoring!\n");
+                    break;
+                }
             }
         }
     }
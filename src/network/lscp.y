@@ -405,6 +405,8 @@ get_instruction       :  AVAILABLE_ENGINES
                       |  CHANNEL SP VOICE_COUNT SP sampler_channel                                  { $$ = LSCPSERVER->GetVoiceCount($5);                              }
                       |  ENGINE SP INFO SP engine_name                                              { $$ = LSCPSERVER->GetEngineInfo($5);                              }
                       |  SERVER SP INFO                                                             { $$ = LSCPSERVER->GetServerInfo();                                }
+                      |  MEMORY SP INFO                                                             { $$ = LSCPSERVER->GetMemoryInfo();                                }
+                      |  VOICE_CULLING SP INFO                                                      { $$ = LSCPSERVER->GetVoiceCullingInfo();                          }
                       |  TOTAL_STREAM_COUNT                                                         { $$ = LSCPSERVER->GetTotalStreamCount();                           }
                       |  TOTAL_VOICE_COUNT                                                          { $$ = LSCPSERVER->GetTotalVoiceCount();                           }
                       |  TOTAL_VOICE_COUNT_MAX                                                      { $$ = LSCPSERVER->GetTotalVoiceCountMax();                        }
@@ -424,6 +426,7 @@ get_instruction       :  AVAILABLE_ENGINES
                       |  DB_INSTRUMENTS_JOB SP INFO SP number                                       { $$ = LSCPSERVER->GetDbInstrumentsJobInfo($5);                    }
                       |  VOLUME                                                                     { $$ = LSCPSERVER->GetGlobalVolume();                              }
                       |  VOICES                                                                     { $$ = LSCPSERVER->GetGlobalMaxVoices();                           }
+                      |  CPU_AFFINITY SP string                                                     { $$ = LSCPSERVER->GetCpuAffinity($3);                             }
                       |  STREAMS                                                                    { $$ = LSCPSERVER->GetGlobalMaxStreams();                          }
                       |  FILE SP INSTRUMENTS SP filename                                            { $$ = LSCPSERVER->GetFileInstruments($5);                         }
                       |  FILE SP INSTRUMENT SP INFO SP filename SP instrument_index                 { $$ = LSCPSERVER->GetFileInstrumentInfo($7,$9);                   }
@@ -453,7 +456,9 @@ set_instruction       :  AUDIO_OUTPUT_DEVICE_PARAMETER SP number SP string '=' p
                       |  SHELL SP DOC SP boolean                                                          { $$ = LSCPSERVER->SetShellDoc((yyparse_param_t*) yyparse_param, $5); }
                       |  VOLUME SP volume_value                                                           { $$ = LSCPSERVER->SetGlobalVolume($3);                            }
                       |  VOICES SP number                                                                 { $$ = LSCPSERVER->SetGlobalMaxVoices($3);                         }
+                      |  VOICE_CULLING SP THRESHOLD SP volume_value                                       { $$ = LSCPSERVER->SetVoiceCullThreshold($5);                      }
                       |  STREAMS SP number                                                                { $$ = LSCPSERVER->SetGlobalMaxStreams($3);                        }
+                      |  CPU_AFFINITY SP string SP string                                                 { $$ = LSCPSERVER->SetCpuAffinity($3,$5);                          }
                       ;
 
 create_instruction    :  AUDIO_OUTPUT_DEVICE SP string SP key_val_list  { $$ = LSCPSERVER->CreateAudioOutputDevice($3,$5); }
@@ -1237,6 +1242,18 @@ FILE_PATH                  :  'F''I''L''E''_''P''A''T''H'
 SERVER                :  'S''E''R''V''E''R'
                       ;
 
+MEMORY                :  'M''E''M''O''R''Y'
+                      ;
+
+VOICE_CULLING         :  'V''O''I''C''E''_''C''U''L''L''I''N''G'
+                      ;
+
+THRESHOLD             :  'T''H''R''E''S''H''O''L''D'
+                      ;
+
+CPU_AFFINITY          :  'C''P''U''_''A''F''F''I''N''I''T''Y'
+                      ;
+
 VOLUME                :  'V''O''L''U''M''E'
                       ;
 
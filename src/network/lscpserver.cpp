@@ -25,6 +25,7 @@
 #include <string>
 
 #include "../common/File.h"
+#include "../common/HugePageAllocator.h"
 #include "lscpserver.h"
 #include "lscpresultset.h"
 #include "lscpevent.h"
@@ -42,6 +43,7 @@ typedef unsigned long in_addr_t;
 #endif
 
 #include "../engines/EngineFactory.h"
+#include "../engines/AbstractEngine.h"
 #include "../engines/EngineChannelFactory.h"
 #include "../drivers/audio/AudioOutputDeviceFactory.h"
 #include "../drivers/midi/MidiInputDeviceFactory.h"
@@ -112,6 +114,7 @@ Mutex LSCPServer::SubscriptionMutex;
 Mutex LSCPServer::RTNotifyMutex;
 
 LSCPServer::LSCPServer(Sampler* pSampler, long int addr, short int port) : Thread(true, false, 0, -4), eventHandler(this) {
+    SetRole(ROLE_LSCP);
     SocketAddress.sin_family      = AF_INET;
     SocketAddress.sin_addr.s_addr = (in_addr_t)addr;
     SocketAddress.sin_port        = (in_port_t)port;
@@ -3249,6 +3252,85 @@ String LSCPServer::GetServerInfo() {
     return result.Produce();
 }
 
+/**
+ * Will be called by the parser to return the amount of memory currently
+ * allocated for disk stream buffers and sample RAM caches.
+ */
+String LSCPServer::GetMemoryInfo() {
+    dmsg(2,("LSCPServer: GetMemoryInfo()\n"));
+    HugePageAllocator::statistics_t stats = HugePageAllocator::GetStatistics();
+    LSCPResultSet result;
+    result.Add("BUFFERS_SIZE", ToString(stats.AllocatedBytes));
+    result.Add("HUGE_PAGES_SIZE", ToString(stats.HugePageBytes));
+    result.Add("NUMA_BOUND_SIZE", ToString(stats.NumaBoundBytes));
+    result.Add("NUMA_REMOTE_SIZE", ToString(stats.NumaRemoteBytes));
+    return result.Produce();
+}
+
+/**
+ * Will be called by the parser to return the current voice culling threshold
+ * and how many voices were skipped or freed early because of it.
+ */
+String LSCPServer::GetVoiceCullingInfo() {
+    dmsg(2,("LSCPServer: GetVoiceCullingInfo()\n"));
+    AbstractEngine::culling_statistics_t stats = AbstractEngine::GetCullingStatistics();
+    LSCPResultSet result;
+    result.Add("THRESHOLD", ToString(GLOBAL_VOICE_CULL_THRESHOLD));
+    result.Add("INAUDIBLE_VOICES", stats.InaudibleVoices);
+    result.Add("CULLED_VOICES", stats.CulledVoices);
+    return result.Produce();
+}
+
+/**
+ * Will be called by the parser to change the level below which voices are
+ * regarded to be inaudible, 0 disables voice culling.
+ */
+String LSCPServer::SetVoiceCullThreshold(double dThreshold) {
+    dmsg(2,("LSCPServer: SetVoiceCullThreshold(%f)\n", dThreshold));
+    LSCPResultSet result;
+    try {
+        if (dThreshold < 0) throw Exception("Threshold may not be negative");
+        GLOBAL_VOICE_CULL_THRESHOLD = dThreshold; // see common/global_private.cpp
+        LSCPServer::SendLSCPNotify(LSCPEvent(LSCPEvent::event_global_info, "VOICE_CULL_THRESHOLD", GLOBAL_VOICE_CULL_THRESHOLD));
+    } catch (Exception e) {
+        result.Error(e);
+    }
+    return result.Produce();
+}
+
+/**
+ * Will be called by the parser to return the CPUs the threads of the given
+ * role are pinned to.
+ */
+String LSCPServer::GetCpuAffinity(String Role) {
+    dmsg(2,("LSCPServer: GetCpuAffinity(%s)\n", Role.c_str()));
+    LSCPResultSet result;
+    Thread::role_t role;
+    if (Thread::RoleByName(Role, role))
+        result.Add(Thread::CpuListToString(Thread::GetCpuAffinity(role)));
+    else
+        result.Error("Unknown thread role '" + Role + "'");
+    return result.Produce();
+}
+
+/**
+ * Will be called by the parser to pin all threads of the given role to the
+ * given CPUs.
+ */
+String LSCPServer::SetCpuAffinity(String Role, String Cpus) {
+    dmsg(2,("LSCPServer: SetCpuAffinity(%s,%s)\n", Role.c_str(), Cpus.c_str()));
+    LSCPResultSet result;
+    Thread::role_t role;
+    std::vector<int> cpus;
+    if (!Thread::RoleByName(Role, role))
+        result.Error("Unknown thread role '" + Role + "'");
+    else if (!Thread::ParseCpuList(Cpus, cpus))
+        result.Error("Invalid CPU list '" + Cpus + "'");
+    else if (!Thread::SetCpuAffinity(role, cpus))
+        result.Error("Could not assign CPU affinity (not supported on this system or invalid CPU)");
+    return result.Produce();
+}
+
 /**
  * Will be called by the parser to return the current number of all active streams.
  */
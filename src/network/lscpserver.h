@@ -223,6 +223,11 @@ class LSCPServer : public Thread {
         String ResetChannel(uint uiSamplerChannel);
         String ResetSampler();
         String GetServerInfo();
+        String GetMemoryInfo();
+        String GetVoiceCullingInfo();
+        String SetVoiceCullThreshold(double dThreshold);
+        String GetCpuAffinity(String Role);
+        String SetCpuAffinity(String Role, String Cpus);
         String GetTotalStreamCount();
         String GetTotalVoiceCount();
         String GetTotalVoiceCountMax();
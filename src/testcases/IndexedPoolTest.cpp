@@ -0,0 +1,199 @@
+#include "IndexedPoolTest.h"
+
+#include <iostream>
+#include <vector>
+#include <stdlib.h>
+
+#define LISTS        4    // amount of lists besides the pool's own list
+#define OPERATIONS   20000
+#define SEED         4711
+
+CPPUNIT_TEST_SUITE_REGISTRATION(IndexedPoolTest);
+
+using namespace std;
+
+// One pool with its lists, P and L being either Reference::Pool and
+// Reference::RTList or Indexed::Pool and Indexed::RTList. Elements are addressed by their
+// position on a list, since the iterators of both implementations can't be
+// compared with each other.
+template<template<typename> class P, template<typename> class L>
+struct PoolModel {
+    typedef typename P<int>::Iterator Iterator;
+
+    P<int>* pPool;
+    L<int>* pLists[LISTS + 1]; // [0] is the pool itself
+
+    PoolModel(int Elements) {
+        pPool = new P<int>(Elements);
+        pLists[0] = pPool;
+        for (int i = 1; i <= LISTS; i++) pLists[i] = new L<int>(pPool);
+    }
+
+    ~PoolModel() {
+        for (int i = 1; i <= LISTS; i++) delete pLists[i];
+        // Pool's destructor frees its nodes before its own list is cleared
+        pPool->clear();
+        delete pPool;
+    }
+
+    Iterator at(int list, int pos) {
+        Iterator it = pLists[list]->first();
+        for (int i = 0; i < pos; i++) ++it;
+        return it;
+    }
+
+    // returns the values of the given list, read forward and backward
+    vector<int> values(int list, bool backward = false) {
+        vector<int> v;
+        if (backward) {
+            for (Iterator it = pLists[list]->last(); it != pLists[list]->begin(); --it)
+                v.insert(v.begin(), *it);
+        } else {
+            for (Iterator it = pLists[list]->first(); it != pLists[list]->end(); ++it)
+                v.push_back(*it);
+        }
+        return v;
+    }
+};
+
+typedef PoolModel<Reference::Pool, Reference::RTList> ReferenceModel;
+typedef PoolModel<Indexed::Pool, Indexed::RTList> IndexedModel;
+
+// checks that both models contain the same elements in the same order
+static void compare(ReferenceModel& ref, IndexedModel& idx) {
+    CPPUNIT_ASSERT(ref.pPool->poolIsEmpty() == idx.pPool->poolIsEmpty());
+    for (int l = 0; l <= LISTS; l++) {
+        CPPUNIT_ASSERT(ref.pLists[l]->isEmpty() == idx.pLists[l]->isEmpty());
+        CPPUNIT_ASSERT(ref.pLists[l]->count() == idx.pLists[l]->count());
+        CPPUNIT_ASSERT(ref.values(l) == idx.values(l));
+        CPPUNIT_ASSERT(ref.values(l, true) == idx.values(l, true));
+    }
+}
+
+static void runRandomOperations(int Elements) {
+    ReferenceModel ref(Elements);
+    IndexedModel   idx(Elements);
+    vector<Reference::pool_element_id_t> refIDs; // IDs of freed elements
+    vector<Indexed::pool_element_id_t>   idxIDs;
+    int nextValue = 0;
+    srand(SEED);
+
+    for (int op = 0; op < OPERATIONS; op++) {
+        const int list  = rand() % (LISTS + 1);
+        const int count = ref.pLists[list]->count();
+        const int pos   = count ? rand() % count : 0;
+        switch (rand() % 8) {
+            case 0:
+            case 1: { // allocate an element at the end or beginning
+                const bool append = rand() % 2;
+                ReferenceModel::Iterator itRef =
+                    append ? ref.pLists[list]->allocAppend() : ref.pLists[list]->allocPrepend();
+                IndexedModel::Iterator itIdx =
+                    append ? idx.pLists[list]->allocAppend() : idx.pLists[list]->allocPrepend();
+                CPPUNIT_ASSERT(bool(itRef) == bool(itIdx));
+                if (itRef) *itRef = *itIdx = nextValue++;
+                break;
+            }
+            case 2: { // free an element
+                if (!count) break;
+                ReferenceModel::Iterator itRef = ref.at(list, pos);
+                IndexedModel::Iterator   itIdx = idx.at(list, pos);
+                refIDs.push_back(ref.pPool->getID(itRef));
+                idxIDs.push_back(idx.pPool->getID(itIdx));
+                ref.pLists[list]->free(itRef);
+                idx.pLists[list]->free(itIdx);
+                break;
+            }
+            case 3: { // move an element to the end or beginning of a list
+                if (!count) break;
+                const int dst = rand() % (LISTS + 1);
+                const bool toEnd = rand() % 2;
+                ReferenceModel::Iterator itRef = ref.at(list, pos);
+                IndexedModel::Iterator   itIdx = idx.at(list, pos);
+                if (toEnd) {
+                    itRef.moveToEndOf(ref.pLists[dst]);
+                    itIdx.moveToEndOf(idx.pLists[dst]);
+                } else {
+                    itRef.moveToBeginOf(ref.pLists[dst]);
+                    itIdx.moveToBeginOf(idx.pLists[dst]);
+                }
+                break;
+            }
+            case 4: { // move an element before or after another element
+                const int dst = rand() % (LISTS + 1);
+                const int dstCount = ref.pLists[dst]->count();
+                if (!count || !dstCount) break;
+                const int dstPos = rand() % dstCount;
+                if (dst == list && dstPos == pos) break;
+                const bool before = rand() % 2;
+                ReferenceModel::Iterator itRef = ref.at(list, pos);
+                IndexedModel::Iterator   itIdx = idx.at(list, pos);
+                if (before) {
+                    itRef.moveBefore(ref.at(dst, dstPos));
+                    itIdx.moveBefore(idx.at(dst, dstPos));
+                } else {
+                    itRef.moveAfter(ref.at(dst, dstPos));
+                    itIdx.moveAfter(idx.at(dst, dstPos));
+                }
+                break;
+            }
+            case 5: { // resolve the ID of an element in use
+                if (!count) break;
+                ReferenceModel::Iterator itRef = ref.pPool->fromID(ref.pPool->getID(ref.at(list, pos)));
+                IndexedModel::Iterator   itIdx = idx.pPool->fromID(idx.pPool->getID(idx.at(list, pos)));
+                CPPUNIT_ASSERT(itRef && itIdx);
+                CPPUNIT_ASSERT(*itRef == *itIdx);
+                break;
+            }
+            case 6: { // resolve the ID of a freed element
+                if (refIDs.empty()) break;
+                const int i = rand() % refIDs.size();
+                CPPUNIT_ASSERT(!ref.pPool->fromID(refIDs[i]));
+                CPPUNIT_ASSERT(!idx.pPool->fromID(idxIDs[i]));
+                break;
+            }
+            case 7: { // clear a list now and then
+                if (rand() % 16) break;
+                ref.pLists[list]->clear();
+                idx.pLists[list]->clear();
+                // the elements' reincarnation counters are bounded, so only
+                // keep recently freed IDs around
+                refIDs.clear();
+                idxIDs.clear();
+                break;
+            }
+        }
+        compare(ref, idx);
+    }
+}
+
+
+// IndexedPoolTest
+
+void IndexedPoolTest::printTestSuiteName() {
+    cout << "\b \nRunning IndexedPool Tests: " << flush;
+}
+
+void IndexedPoolTest::testRandomOperations() {
+    runRandomOperations(100);
+}
+
+// running out of elements happens often on a tiny pool
+void IndexedPoolTest::testRandomOperationsOnTinyPool() {
+    runRandomOperations(3);
+}
+
+void IndexedPoolTest::testResizePool() {
+    ReferenceModel ref(10);
+    IndexedModel   idx(10);
+    ref.pPool->resizePool(50);
+    idx.pPool->resizePool(50);
+    CPPUNIT_ASSERT(ref.pPool->poolSize() == idx.pPool->poolSize());
+    for (int i = 0; i < 50; i++) {
+        *ref.pLists[1]->allocAppend() = i;
+        *idx.pLists[1]->allocAppend() = i;
+    }
+    compare(ref, idx);
+    CPPUNIT_ASSERT(!ref.pLists[1]->allocAppend());
+    CPPUNIT_ASSERT(!idx.pLists[1]->allocAppend());
+}
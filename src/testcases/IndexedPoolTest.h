@@ -0,0 +1,72 @@
+#ifndef __LS_INDEXEDPOOLTEST_H__
+#define __LS_INDEXEDPOOLTEST_H__
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+// set options for Pool.h (same as in PoolTest.h)
+
+#ifdef CONFIG_DEVMODE
+# undef CONFIG_DEVMODE
+#endif
+#define CONFIG_DEVMODE 1
+
+#ifdef CONFIG_RT_EXCEPTIONS
+# undef CONFIG_RT_EXCEPTIONS
+#endif
+#define CONFIG_RT_EXCEPTIONS 1
+
+// Compile both Pool implementations into their own namespace, so they can
+// be compared with each other regardless of CONFIG_INDEXED_POOL. Include
+// everything Pool.h and IndexedPool.h include beforehand, so it doesn't end
+// up in those namespaces.
+
+#include <stdint.h>
+#include <string>
+#include <iostream>
+#include <stdexcept>
+#include "../common/Mutex.h"
+
+#undef HAVE_CONFIG_H // config.h would override CONFIG_INDEXED_POOL
+
+#undef CONFIG_INDEXED_POOL
+#define CONFIG_INDEXED_POOL 0
+namespace Reference {
+    #include "../common/Pool.h"
+}
+
+#undef __LS_POOL_H__
+#undef CONFIG_INDEXED_POOL
+#define CONFIG_INDEXED_POOL 1
+namespace Indexed {
+    #include "../common/Pool.h"
+}
+
+/**
+ * Performs the same random sequence of operations (allocating, freeing and
+ * moving elements between several lists, clearing lists and resolving
+ * element IDs) on a Reference::Pool (the pointer based implementation) and
+ * an Indexed::Pool (see IndexedPool.h), and checks after each
+ * operation that both contain the same elements in the same order.
+ */
+class IndexedPoolTest : public CppUnit::TestFixture {
+
+    CPPUNIT_TEST_SUITE(IndexedPoolTest);
+    CPPUNIT_TEST(printTestSuiteName);
+    CPPUNIT_TEST(testRandomOperations);
+    CPPUNIT_TEST(testRandomOperationsOnTinyPool);
+    CPPUNIT_TEST(testResizePool);
+    CPPUNIT_TEST_SUITE_END();
+
+    public:
+        void printTestSuiteName();
+        void testRandomOperations();
+        void testRandomOperationsOnTinyPool();
+        void testResizePool();
+};
+
+#endif // __LS_INDEXEDPOOLTEST_H__
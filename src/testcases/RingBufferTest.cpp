@@ -0,0 +1,152 @@
+#include "RingBufferTest.h"
+
+#include <iostream>
+#include <sys/time.h>
+#include <sched.h>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(RingBufferTest);
+
+using namespace std;
+
+// amount of elements passed from producer to consumer thread in the stress test
+#define STRESS_ELEMENTS 10000000
+
+
+// ProducerThread
+
+RingBufferTest::ProducerThread::ProducerThread(RingBuffer<int,false>* pBuffer, int Elements) : LinuxSampler::Thread(false, false, 0, -4) {
+    this->pBuffer = pBuffer;
+    elements = Elements;
+}
+
+int RingBufferTest::ProducerThread::Main() {
+    int chunk[37];
+    for (int i = 0; i < elements; ) {
+        // alternate between immediate and deferred publishing
+        int n = 0;
+        for (; n < 37 && i + n < elements; n++) chunk[n] = i + n;
+        int written;
+        if (i & 1) {
+            written = pBuffer->write(chunk, n);
+        } else {
+            written = pBuffer->write_deferred(chunk, n);
+            pBuffer->publish_write();
+        }
+        if (!written) sched_yield();
+        i += written;
+    }
+    return 0;
+}
+
+
+// RingBufferTest
+
+void RingBufferTest::printTestSuiteName() {
+    cout << "\b \nRunning RingBuffer Tests: " << flush;
+}
+
+// write some elements and read them back
+void RingBufferTest::testWriteRead() {
+    RingBuffer<int,false> buf(16, 0);
+    CPPUNIT_ASSERT(buf.size == 16);
+    CPPUNIT_ASSERT(buf.write_space() == 15);
+    CPPUNIT_ASSERT(buf.read_space() == 0);
+
+    int data[20];
+    for (int i = 0; i < 20; i++) data[i] = i;
+    CPPUNIT_ASSERT(buf.write(data, 20) == 15); // one element always stays free
+    CPPUNIT_ASSERT(buf.write_space() == 0);
+    CPPUNIT_ASSERT(buf.read_space() == 15);
+    CPPUNIT_ASSERT(buf.write(data, 1) == 0);
+
+    int result[20];
+    CPPUNIT_ASSERT(buf.read(result, 20) == 15);
+    for (int i = 0; i < 15; i++) CPPUNIT_ASSERT(result[i] == i);
+    CPPUNIT_ASSERT(buf.read_space() == 0);
+    CPPUNIT_ASSERT(buf.read(result, 1) == 0);
+}
+
+// write and read across the end of the buffer several times
+void RingBufferTest::testWrapAround() {
+    RingBuffer<int,false> buf(16, 0);
+    int next = 0, expected = 0;
+    for (int round = 0; round < 100; round++) {
+        int data[11];
+        for (int i = 0; i < 11; i++) data[i] = next + i;
+        const int written = buf.write(data, 11);
+        CPPUNIT_ASSERT(written == 11);
+        next += written;
+
+        int result[11];
+        const int read = buf.read(result, 11);
+        CPPUNIT_ASSERT(read == 11);
+        for (int i = 0; i < read; i++) CPPUNIT_ASSERT(result[i] == expected++);
+    }
+}
+
+// elements written with write_deferred() must not be visible before publish_write()
+void RingBufferTest::testDeferredWrite() {
+    RingBuffer<int,false> buf(16, 0);
+    int data[10];
+    for (int i = 0; i < 10; i++) data[i] = i;
+    CPPUNIT_ASSERT(buf.write_deferred(data, 4) == 4);
+    CPPUNIT_ASSERT(buf.write_deferred(data + 4, 6) == 6);
+    CPPUNIT_ASSERT(buf.read_space() == 0);
+    buf.publish_write();
+    CPPUNIT_ASSERT(buf.read_space() == 10);
+
+    int result[10];
+    CPPUNIT_ASSERT(buf.read(result, 10) == 10);
+    for (int i = 0; i < 10; i++) CPPUNIT_ASSERT(result[i] == i);
+}
+
+// advancing positions without read() / write() must not confuse the cached positions
+void RingBufferTest::testIncrementPointers() {
+    RingBuffer<int,false> buf(16, 0);
+    int data[15];
+    for (int i = 0; i < 15; i++) data[i] = i;
+    CPPUNIT_ASSERT(buf.write(data, 4) == 4);
+    CPPUNIT_ASSERT(buf.read(data, 4) == 4);
+
+    // fill the buffer completely by direct access
+    const int n = buf.write_space();
+    CPPUNIT_ASSERT(n == 15);
+    buf.increment_write_ptr(n);
+    CPPUNIT_ASSERT(buf.write(data, 1) == 0);
+    CPPUNIT_ASSERT(buf.read_space() == 15);
+
+    // drain it completely by direct access
+    buf.increment_read_ptr(buf.read_space());
+    CPPUNIT_ASSERT(buf.read(data, 1) == 0);
+    CPPUNIT_ASSERT(buf.write(data, 15) == 15);
+    CPPUNIT_ASSERT(buf.read_space() == 15);
+}
+
+// pass a long sequence from a producer thread to this (consumer) thread,
+// check it arrives complete and in order and print the throughput
+void RingBufferTest::testProducerConsumer() {
+    RingBuffer<int,false> buf(1024, 0);
+    ProducerThread producer(&buf, STRESS_ELEMENTS);
+
+    timeval start, end;
+    gettimeofday(&start, NULL);
+    producer.StartThread();
+
+    int expected = 0;
+    bool inOrder = true;
+    int chunk[53];
+    while (expected < STRESS_ELEMENTS) {
+        const int n = buf.read(chunk, 53);
+        if (!n) sched_yield();
+        for (int i = 0; i < n; i++)
+            if (chunk[i] != expected++) inOrder = false;
+    }
+
+    gettimeofday(&end, NULL);
+    producer.StopThread();
+    CPPUNIT_ASSERT(inOrder);
+    CPPUNIT_ASSERT(buf.read_space() == 0);
+
+    const double seconds = (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1000000.0;
+    cout << "(" << int(STRESS_ELEMENTS / seconds / 1000000.0) << " M elements/s) " << flush;
+}
@@ -0,0 +1,49 @@
+#ifndef __LS_RINGBUFFERTEST_H__
+#define __LS_RINGBUFFERTEST_H__
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+// the RingBuffer class we want to test
+#include "../common/RingBuffer.h"
+
+#include "../common/Thread.h"
+
+class RingBufferTest : public CppUnit::TestFixture {
+
+    CPPUNIT_TEST_SUITE(RingBufferTest);
+    CPPUNIT_TEST(printTestSuiteName);
+    CPPUNIT_TEST(testWriteRead);
+    CPPUNIT_TEST(testWrapAround);
+    CPPUNIT_TEST(testDeferredWrite);
+    CPPUNIT_TEST(testIncrementPointers);
+    CPPUNIT_TEST(testProducerConsumer);
+    CPPUNIT_TEST_SUITE_END();
+
+    public:
+        // writes an ascending sequence of integers in chunks of varying size to the ring buffer
+        class ProducerThread : public LinuxSampler::Thread {
+            public:
+                ProducerThread(RingBuffer<int,false>* pBuffer, int Elements);
+                int Main();
+            private:
+                RingBuffer<int,false>* pBuffer;
+                int elements;
+        };
+
+        void setUp() {
+        }
+
+        void tearDown() {
+        }
+
+        void printTestSuiteName();
+
+        void testWriteRead();
+        void testWrapAround();
+        void testDeferredWrite();
+        void testIncrementPointers();
+        void testProducerConsumer();
+};
+
+#endif // __LS_RINGBUFFERTEST_H__